@@ -0,0 +1,243 @@
+#include <array>
+#include <atomic>
+#include <stdexcept>
+
+#include "Alignments.h"
+#include "ConnectN.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ALIGNMENTS_AVX2
+#include <immintrin.h>
+#endif
+
+/* Bit distances between two neighbour cells: vertical, horizontal and both
+ * diagonals; the sentinel bit of each column stops the runs at the edges */
+static std::array<unsigned, 4> directions(unsigned line)
+{
+    return {{1, line + 1, line + 2, line}};
+}
+
+static void checkPower(unsigned power)
+{
+    if (power < ConnectN::MIN_POWER || power > ConnectN::MAX_POWER) {
+        throw std::out_of_range("Power must be comprised between 3 and 10");
+    }
+}
+
+/* AVX2 may be used, when the processor has it */
+static std::atomic<bool> avx2Allowed(true);
+
+/* Scalar kernels, on 64-bit words */
+
+static bool alignedScalar(const BitPlane &own, unsigned power,
+                          const std::array<unsigned, 4> &shifts)
+{
+    for (unsigned shift : shifts) {
+        BitPlane runs = own;
+        for (unsigned i = 1; i < power; i++) {
+            runs = own & (runs >> shift);
+        }
+        if (runs.any()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static BitPlane threatsScalar(const BitPlane &own, const BitPlane &empty,
+                              unsigned power,
+                              const std::array<unsigned, 4> &shifts)
+{
+    BitPlane threats;
+
+    for (unsigned shift : shifts) {
+        /* before[i]: the i cells before are the color's, after[i]: the i
+         * cells after */
+        std::array<BitPlane, ConnectN::MAX_POWER> before;
+        std::array<BitPlane, ConnectN::MAX_POWER> after;
+        before[0] = ~BitPlane();
+        after[0] = ~BitPlane();
+        for (unsigned i = 1; i < power; i++) {
+            before[i] = (own & before[i - 1]) << shift;
+            after[i] = (own & after[i - 1]) >> shift;
+        }
+        for (unsigned i = 0; i < power; i++) {
+            threats |= before[i] & after[power - 1 - i];
+        }
+    }
+
+    return threats & empty;
+}
+
+#ifdef ALIGNMENTS_AVX2
+
+/* AVX2 kernels, on a low and a high vector of 4 words each; a shift moves
+ * each word and carries the bits crossing into the neighbour word, brought
+ * in by a lane permutation */
+
+__attribute__((target("avx2")))
+static inline void up(__m256i &low, __m256i &high, unsigned shift)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m128i count = _mm_cvtsi32_si128(shift);
+    __m128i carry = _mm_cvtsi32_si128(64 - shift);
+    /* [w3, w0, w1, w2] */
+    __m256i rotatedLow = _mm256_permute4x64_epi64(low, _MM_SHUFFLE(2, 1, 0, 3));
+    __m256i rotatedHigh = _mm256_permute4x64_epi64(high, _MM_SHUFFLE(2, 1, 0, 3));
+    __m256i previousLow = _mm256_blend_epi32(rotatedLow, zero, 0x03);
+    __m256i previousHigh = _mm256_blend_epi32(rotatedHigh, rotatedLow, 0x03);
+
+    low = _mm256_or_si256(_mm256_sll_epi64(low, count),
+                          _mm256_srl_epi64(previousLow, carry));
+    high = _mm256_or_si256(_mm256_sll_epi64(high, count),
+                           _mm256_srl_epi64(previousHigh, carry));
+}
+
+__attribute__((target("avx2")))
+static inline void down(__m256i &low, __m256i &high, unsigned shift)
+{
+    __m256i zero = _mm256_setzero_si256();
+    __m128i count = _mm_cvtsi32_si128(shift);
+    __m128i carry = _mm_cvtsi32_si128(64 - shift);
+    /* [w1, w2, w3, w0] */
+    __m256i rotatedLow = _mm256_permute4x64_epi64(low, _MM_SHUFFLE(0, 3, 2, 1));
+    __m256i rotatedHigh = _mm256_permute4x64_epi64(high, _MM_SHUFFLE(0, 3, 2, 1));
+    __m256i nextLow = _mm256_blend_epi32(rotatedLow, rotatedHigh, 0xc0);
+    __m256i nextHigh = _mm256_blend_epi32(rotatedHigh, zero, 0xc0);
+
+    low = _mm256_or_si256(_mm256_srl_epi64(low, count),
+                          _mm256_sll_epi64(nextLow, carry));
+    high = _mm256_or_si256(_mm256_srl_epi64(high, count),
+                           _mm256_sll_epi64(nextHigh, carry));
+}
+
+__attribute__((target("avx2")))
+static bool alignedAvx2(const BitPlane &own, unsigned power,
+                        const std::array<unsigned, 4> &shifts)
+{
+    const __m256i *words = reinterpret_cast<const __m256i *>(own.words().data());
+    __m256i ownLow = _mm256_loadu_si256(words);
+    __m256i ownHigh = _mm256_loadu_si256(words + 1);
+
+    for (unsigned shift : shifts) {
+        __m256i runsLow = ownLow;
+        __m256i runsHigh = ownHigh;
+        for (unsigned i = 1; i < power; i++) {
+            down(runsLow, runsHigh, shift);
+            runsLow = _mm256_and_si256(runsLow, ownLow);
+            runsHigh = _mm256_and_si256(runsHigh, ownHigh);
+        }
+        __m256i runs = _mm256_or_si256(runsLow, runsHigh);
+        if (!_mm256_testz_si256(runs, runs)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+__attribute__((target("avx2")))
+static BitPlane threatsAvx2(const BitPlane &own, const BitPlane &empty,
+                            unsigned power,
+                            const std::array<unsigned, 4> &shifts)
+{
+    const __m256i *words = reinterpret_cast<const __m256i *>(own.words().data());
+    const __m256i *cells = reinterpret_cast<const __m256i *>(empty.words().data());
+    __m256i ownLow = _mm256_loadu_si256(words);
+    __m256i ownHigh = _mm256_loadu_si256(words + 1);
+    __m256i ones = _mm256_set1_epi64x(-1);
+    __m256i threatsLow = _mm256_setzero_si256();
+    __m256i threatsHigh = _mm256_setzero_si256();
+    std::array<std::uint64_t, BitPlane::WORDS> result;
+
+    for (unsigned shift : shifts) {
+        __m256i beforeLow[ConnectN::MAX_POWER];
+        __m256i beforeHigh[ConnectN::MAX_POWER];
+        __m256i afterLow[ConnectN::MAX_POWER];
+        __m256i afterHigh[ConnectN::MAX_POWER];
+        beforeLow[0] = beforeHigh[0] = afterLow[0] = afterHigh[0] = ones;
+        for (unsigned i = 1; i < power; i++) {
+            beforeLow[i] = _mm256_and_si256(ownLow, beforeLow[i - 1]);
+            beforeHigh[i] = _mm256_and_si256(ownHigh, beforeHigh[i - 1]);
+            up(beforeLow[i], beforeHigh[i], shift);
+            afterLow[i] = _mm256_and_si256(ownLow, afterLow[i - 1]);
+            afterHigh[i] = _mm256_and_si256(ownHigh, afterHigh[i - 1]);
+            down(afterLow[i], afterHigh[i], shift);
+        }
+        for (unsigned i = 0; i < power; i++) {
+            threatsLow = _mm256_or_si256(threatsLow, _mm256_and_si256(
+                                             beforeLow[i], afterLow[power - 1 - i]));
+            threatsHigh = _mm256_or_si256(threatsHigh, _mm256_and_si256(
+                                              beforeHigh[i], afterHigh[power - 1 - i]));
+        }
+    }
+
+    threatsLow = _mm256_and_si256(threatsLow, _mm256_loadu_si256(cells));
+    threatsHigh = _mm256_and_si256(threatsHigh, _mm256_loadu_si256(cells + 1));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(result.data()), threatsLow);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(result.data()) + 1,
+                        threatsHigh);
+    return BitPlane(result);
+}
+
+#endif
+
+bool Alignments::aligned(const BitBoard &board, Color color, unsigned power)
+{
+    checkPower(power);
+#ifdef ALIGNMENTS_AVX2
+    if (vectorized()) {
+        return alignedAvx2(board.plane(color), power, directions(board.line()));
+    }
+#endif
+    return alignedScalar(board.plane(color), power, directions(board.line()));
+}
+
+BitPlane Alignments::threats(const BitBoard &board, Color color,
+                             unsigned power)
+{
+    BitPlane empty = cells(board.line(), board.column())
+            & ~(board.plane(Color::BLACK) | board.plane(Color::WHITE));
+    return threats(board.plane(color), empty, board.line(), power);
+}
+
+BitPlane Alignments::threats(const BitPlane &own, const BitPlane &empty,
+                             unsigned line, unsigned power)
+{
+    checkPower(power);
+#ifdef ALIGNMENTS_AVX2
+    if (vectorized()) {
+        return threatsAvx2(own, empty, power, directions(line));
+    }
+#endif
+    return threatsScalar(own, empty, power, directions(line));
+}
+
+BitPlane Alignments::cells(unsigned line, unsigned column)
+{
+    BitPlane cells;
+    BitPlane cellsOfColumn;
+
+    for (unsigned i = 0; i < line; i++) {
+        cellsOfColumn.set(i);
+    }
+    for (unsigned i = 0; i < column; i++) {
+        cells |= cellsOfColumn;
+        cellsOfColumn <<= line + 1;
+    }
+    return cells;
+}
+
+bool Alignments::vectorized()
+{
+#ifdef ALIGNMENTS_AVX2
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2 && avx2Allowed.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+void Alignments::vectorized(bool vectorized)
+{
+    avx2Allowed = vectorized;
+}
@@ -0,0 +1,88 @@
+/*! \file Alignments.h
+ * Alignments class definition
+ */
+
+#ifndef ALIGNMENTS_H
+#define ALIGNMENTS_H
+
+#include "BitBoard.h"
+#include "BitPlane.h"
+#include "Color.h"
+
+/*!
+ * \brief Whole-board alignment queries.
+ * The queries look at every cell of a board at once: the plane of a color
+ * is shifted one cell at a time along each direction and ANDed with itself,
+ * so that the cost only depends on the power, not on the number of pieces.
+ * Planes are handled as 8 64-bit words, or as two 256-bit vectors when the
+ * processor has AVX2; the results are the same, and the words can be
+ * forced with vectorized(bool) to compare both kernels.
+ */
+class Alignments
+{
+public:
+    /*!
+     * \brief Check if a color has power pieces in a row anywhere
+     * \param board the board
+     * \param color the color, BLACK or WHITE
+     * \param power the number of pieces to align
+     * \return `true` if power pieces of the color are aligned
+     * \throw std::out_of_range if power is not between ConnectN::MIN_POWER
+     * and ConnectN::MAX_POWER
+     */
+    static bool aligned(const BitBoard &board, Color color, unsigned power);
+
+    /*!
+     * \brief Return the threats of a color: the empty cells where a piece
+     * of the color would complete an alignment of power pieces. The cells
+     * need not be playable yet.
+     * \param board the board
+     * \param color the color, BLACK or WHITE
+     * \param power the number of pieces to align
+     * \return the bits of the threatening cells, laid out as the BitBoard
+     * planes
+     * \throw std::out_of_range if power is not between ConnectN::MIN_POWER
+     * and ConnectN::MAX_POWER
+     */
+    static BitPlane threats(const BitBoard &board, Color color, unsigned power);
+
+    /*!
+     * \brief Return the threats of a plane of pieces among the given empty
+     * cells, as threats(const BitBoard &, Color, unsigned) does. Planes can
+     * thus be queried with pieces added or removed without a board.
+     * \param own the pieces of the color
+     * \param empty the cells that can still be played
+     * \param line number of lines of the board the planes are laid out for
+     * \param power the number of pieces to align
+     * \return the bits of the threatening cells
+     * \throw std::out_of_range if power is not between ConnectN::MIN_POWER
+     * and ConnectN::MAX_POWER
+     */
+    static BitPlane threats(const BitPlane &own, const BitPlane &empty,
+                            unsigned line, unsigned power);
+
+    /*!
+     * \brief Return the cells of a board
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     * \return the bits of all the cells, sentinels excluded
+     */
+    static BitPlane cells(unsigned line, unsigned column);
+
+    /*!
+     * \brief Check if the queries run on AVX2
+     * \return `true` if the processor has AVX2 and the build supports it
+     */
+    static bool vectorized();
+
+    /*!
+     * \brief Allow the queries to run on AVX2, or force them on 64-bit
+     * words. The setting is shared by all the threads; AVX2 is allowed by
+     * default.
+     * \param vectorized `true` to run on AVX2 when the processor has it,
+     * `false` to always run on 64-bit words
+     */
+    static void vectorized(bool vectorized);
+};
+
+#endif // ALIGNMENTS_H
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "Arena.h"
+
+Arena::Scope::Scope(Arena &arena) :
+    _arena(arena),
+    _current(arena._current),
+    _used(arena._used)
+{ }
+
+Arena::Scope::~Scope()
+{
+    _arena._current = _current;
+    _arena._used = _used;
+}
+
+Arena::Arena(std::size_t blockSize) :
+    _blocks(),
+    _blockSize(blockSize),
+    _current(0),
+    _used(0),
+    _allocations(0)
+{
+    if (blockSize == 0) {
+        throw std::out_of_range("Blocks cannot be empty");
+    }
+}
+
+void *Arena::allocate(std::size_t size, std::size_t alignment)
+{
+    while (true) {
+        /* fill the blocks in order, the next one when the current one is
+         * too full */
+        for (; _current < _blocks.size(); _current++, _used = 0) {
+            Block &block = _blocks[_current];
+            std::uintptr_t base = reinterpret_cast<std::uintptr_t>(
+                        block.data.get());
+            std::uintptr_t start = (base + _used + alignment - 1)
+                    & ~std::uintptr_t(alignment - 1);
+            std::size_t offset = start - base;
+            if (offset + size <= block.size) {
+                _used = offset + size;
+                return block.data.get() + offset;
+            }
+        }
+
+        std::size_t blockSize = std::max(_blockSize, size + alignment);
+        _blocks.push_back(Block{std::unique_ptr<unsigned char[]>(
+                                    new unsigned char[blockSize]),
+                                blockSize});
+        _allocations++;
+    }
+}
+
+void Arena::reset()
+{
+    _current = 0;
+    _used = 0;
+}
+
+std::size_t Arena::capacity() const
+{
+    std::size_t bytes = 0;
+    for (const Block &block : _blocks) {
+        bytes += block.size;
+    }
+    return bytes;
+}
+
+std::uint64_t Arena::allocations() const
+{
+    return _allocations;
+}
+
+Arena &Arena::local()
+{
+    static thread_local Arena arena;
+    return arena;
+}
@@ -0,0 +1,141 @@
+/*! \file Arena.h
+ * Arena class definition
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/*!
+ * \brief A bump allocator for short-lived scratch objects.
+ * Memory is handed out from large blocks by moving a cursor; it is never
+ * given back object by object, but all at once by reset() or at the end of
+ * a Scope. The blocks are kept for the next uses, so that once an arena has
+ * grown to the needs of a search or a game, it no longer calls the system
+ * allocator. Only trivially destructible objects can be made in an arena,
+ * as their destructors are never run.
+ *
+ * An arena is not thread-safe: each thread uses its own, given by local().
+ */
+class Arena
+{
+public:
+    /*!
+     * \brief Default size of the blocks, in bytes
+     */
+    static const std::size_t DEFAULT_BLOCK = 1 << 16;
+
+    /*!
+     * \brief Give back, when destroyed, everything allocated in an arena
+     * since the scope was created
+     */
+    class Scope
+    {
+    private:
+        Arena &_arena;
+        std::size_t _current;
+        std::size_t _used;
+
+    public:
+        /*!
+         * \brief Scope constructor
+         * \param arena the arena to rewind at the end of the scope
+         */
+        explicit Scope(Arena &arena);
+
+        /*!
+         * \brief Scope destructor. Rewind the arena.
+         */
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+    };
+
+private:
+    /* A block from the system allocator */
+    struct Block
+    {
+        std::unique_ptr<unsigned char[]> data;
+        std::size_t size;
+    };
+
+    std::vector<Block> _blocks;
+    std::size_t _blockSize;
+    std::size_t _current; /* index of the block being filled */
+    std::size_t _used; /* bytes used in the block being filled */
+    std::uint64_t _allocations;
+
+public:
+    /*!
+     * \brief Arena constructor. No memory is allocated until needed.
+     * \param blockSize the size of the blocks; larger allocations get a
+     * block of their own size
+     * \throw std::out_of_range if blockSize is 0
+     */
+    explicit Arena(std::size_t blockSize = DEFAULT_BLOCK);
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /*!
+     * \brief Allocate memory
+     * \param size the number of bytes
+     * \param alignment the alignment of the memory, a power of 2
+     * \return the memory, valid until the arena is reset or rewound
+     * \throw std::bad_alloc if a new block cannot be allocated
+     */
+    void *allocate(std::size_t size,
+                   std::size_t alignment = alignof(std::max_align_t));
+
+    /*!
+     * \brief Make copies of an object in the arena
+     * \param count the number of copies
+     * \param value the object to copy
+     * \return the first of the count consecutive copies
+     * \throw std::bad_alloc if a new block cannot be allocated
+     */
+    template <class T>
+    T *make(std::size_t count, const T &value)
+    {
+        static_assert(std::is_trivially_destructible<T>::value,
+                      "Arena objects are never destroyed");
+        T *objects = static_cast<T *>(allocate(count * sizeof(T),
+                                               alignof(T)));
+        for (std::size_t i = 0; i < count; i++) {
+            new (objects + i) T(value);
+        }
+        return objects;
+    }
+
+    /*!
+     * \brief Give back all the memory allocated, keeping the blocks
+     */
+    void reset();
+
+    /*!
+     * \brief Return the size of the blocks held
+     * \return the number of bytes of all the blocks
+     */
+    std::size_t capacity() const;
+
+    /*!
+     * \brief Return the number of calls to the system allocator
+     * \return the number of blocks allocated since the arena was created
+     */
+    std::uint64_t allocations() const;
+
+    /*!
+     * \brief Return the arena of the calling thread
+     * \return the arena of the calling thread, freed when the thread ends
+     */
+    static Arena &local();
+};
+
+#endif // ARENA_H
@@ -0,0 +1,28 @@
+#include <stdexcept>
+
+#include "BitBoard.h"
+
+BitBoard::BitBoard(unsigned line, unsigned column) :
+    _line(line),
+    _column(column),
+    _planes(),
+    _heights()
+{
+    if (line > MAX_LINE || column > MAX_COLUMN) {
+        throw std::out_of_range("Board is too large");
+    }
+}
+
+std::vector<std::vector<Color>> BitBoard::lines() const
+{
+    std::vector<std::vector<Color>> lines(_line,
+                                         std::vector<Color>(_column));
+
+    for (unsigned line = 0; line < _line; line++) {
+        for (unsigned column = 0; column < _column; column++) {
+            lines[line][column] = cell(line, column);
+        }
+    }
+
+    return lines;
+}
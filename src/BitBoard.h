@@ -0,0 +1,257 @@
+/*! \file BitBoard.h
+ * BitBoard class definition
+ */
+
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <array>
+#include <vector>
+
+#include "BitPlane.h"
+#include "Color.h"
+
+/*!
+ * \brief A packed ConnectN board.
+ * The board holds one BitPlane per color and the height of each column.
+ * Cells are stored column by column, from the bottom to the top of the
+ * column, each column being followed by an always empty sentinel bit. As for
+ * ConnectN, line 0 is the top line of the board.
+ */
+class BitBoard
+{
+public:
+    /*!
+     * \brief Maximum number of lines
+     */
+    static const unsigned MAX_LINE = 20;
+
+    /*!
+     * \brief Maximum number of columns
+     */
+    static const unsigned MAX_COLUMN = 20;
+
+private:
+    unsigned _line;
+    unsigned _column;
+    std::array<BitPlane, 2> _planes;
+    std::array<unsigned char, MAX_COLUMN> _heights;
+
+    static_assert((MAX_LINE + 1) * MAX_COLUMN <= BitPlane::BITS,
+                  "A BitPlane must hold the largest board");
+
+public:
+    /*!
+     * \brief BitBoard constructor. The board is empty.
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     * \throw std::out_of_range if the board exceeds MAX_LINE or MAX_COLUMN
+     */
+    BitBoard(unsigned line, unsigned column);
+
+    /*!
+     * \brief Return the number of lines
+     * \return the number of lines
+     */
+    unsigned line() const;
+
+    /*!
+     * \brief Return the number of columns
+     * \return the number of columns
+     */
+    unsigned column() const;
+
+    /*!
+     * \brief Return the bit index of the given cell
+     * \param line the line of the cell
+     * \param column the column of the cell
+     * \return the bit index of the cell in the planes
+     */
+    unsigned bit(unsigned line, unsigned column) const;
+
+    /*!
+     * \brief Return the color of the given cell
+     * \param line the line of the cell
+     * \param column the column of the cell
+     * \return the color of the piece in the cell, Color::NONE if empty
+     */
+    Color cell(unsigned line, unsigned column) const;
+
+    /*!
+     * \brief Return the number of pieces in the given column
+     * \param column the column
+     * \return the number of pieces in the column
+     */
+    unsigned height(unsigned column) const;
+
+    /*!
+     * \brief Check if a piece can be dropped in the given column
+     * \param column the column
+     * \return `true` if the column exists and is not full, `false` otherwise
+     */
+    bool playable(unsigned column) const;
+
+    /*!
+     * \brief Drop a piece in the given column.
+     * The column must be playable.
+     * \param column the column
+     * \param color the color of the piece, BLACK or WHITE
+     * \return the line where the piece landed
+     */
+    unsigned drop(unsigned column, Color color);
+
+    /*!
+     * \brief Remove the top piece of the given column.
+     * The column must hold at least one piece.
+     * \param column the column
+     * \return the line where the piece was
+     */
+    unsigned remove(unsigned column);
+
+    /*!
+     * \brief Count the pieces of a color following the given cell.
+     * Counting starts next to the cell and moves by (dLine, dColumn) until a
+     * cell not holding the color or the edge of the board is reached.
+     * \param line the line of the starting cell
+     * \param column the column of the starting cell
+     * \param dLine the line step: -1, 0 or 1
+     * \param dColumn the column step: -1, 0 or 1
+     * \param color the color, BLACK or WHITE
+     * \param max the maximum number of pieces to count
+     * \return the number of consecutive pieces of the color, at most max
+     */
+    unsigned run(unsigned line, unsigned column, int dLine, int dColumn,
+                 Color color, unsigned max) const;
+
+    /*!
+     * \brief Check if a piece of a color at the given cell would be aligned
+     * with at least power - 1 other pieces of that color. The cell itself is
+     * not read.
+     * \param line the line of the cell
+     * \param column the column of the cell
+     * \param color the color, BLACK or WHITE
+     * \param power the number of pieces to align
+     * \return `true` if power pieces are aligned through the cell, `false`
+     * otherwise
+     */
+    bool aligned(unsigned line, unsigned column, Color color,
+                 unsigned power) const;
+
+    /*!
+     * \brief Return the plane of the given color
+     * \param color the color, BLACK or WHITE
+     * \return the bits of the cells holding a piece of the color
+     */
+    const BitPlane &plane(Color color) const;
+
+    /*!
+     * \brief Return the board as a vector of lines
+     * \return the board as a vector of lines, line 0 being the top line
+     */
+    std::vector<std::vector<Color>> lines() const;
+};
+
+inline unsigned BitBoard::line() const
+{
+    return _line;
+}
+
+inline unsigned BitBoard::column() const
+{
+    return _column;
+}
+
+inline unsigned BitBoard::bit(unsigned line, unsigned column) const
+{
+    return column * (_line + 1) + (_line - 1 - line);
+}
+
+inline Color BitBoard::cell(unsigned line, unsigned column) const
+{
+    unsigned index = bit(line, column);
+    if (_planes[0].test(index)) {
+        return Color::BLACK;
+    } else if (_planes[1].test(index)) {
+        return Color::WHITE;
+    } else {
+        return Color::NONE;
+    }
+}
+
+inline unsigned BitBoard::height(unsigned column) const
+{
+    return _heights[column];
+}
+
+inline bool BitBoard::playable(unsigned column) const
+{
+    return column < _column && _heights[column] < _line;
+}
+
+inline unsigned BitBoard::drop(unsigned column, Color color)
+{
+    unsigned line = _line - 1 - _heights[column]++;
+    _planes[color == Color::WHITE].set(bit(line, column));
+    return line;
+}
+
+inline unsigned BitBoard::remove(unsigned column)
+{
+    unsigned line = _line - _heights[column]--;
+    unsigned index = bit(line, column);
+    _planes[0].reset(index);
+    _planes[1].reset(index);
+    return line;
+}
+
+inline unsigned BitBoard::run(unsigned line, unsigned column,
+                              int dLine, int dColumn,
+                              Color color, unsigned max) const
+{
+    const BitPlane &stones = plane(color);
+    unsigned room = max;
+    unsigned count = 0;
+
+    /* number of cells between the starting cell and the edge of the board */
+    if (dLine > 0 && _line - 1 - line < room) {
+        room = _line - 1 - line;
+    } else if (dLine < 0 && line < room) {
+        room = line;
+    }
+    if (dColumn > 0 && _column - 1 - column < room) {
+        room = _column - 1 - column;
+    } else if (dColumn < 0 && column < room) {
+        room = column;
+    }
+
+    /* lines are stored from the bottom of each column */
+    int step = dColumn * int(_line + 1) - dLine;
+    unsigned index = bit(line, column);
+    while (count < room && stones.test(index += step)) {
+        count++;
+    }
+
+    return count;
+}
+
+inline bool BitBoard::aligned(unsigned line, unsigned column, Color color,
+                              unsigned power) const
+{
+    static const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+
+    for (const auto &direction : directions) {
+        if (1 + run(line, column, direction[0], direction[1], color, power - 1)
+                + run(line, column, -direction[0], -direction[1], color,
+                      power - 1) >= power) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline const BitPlane &BitBoard::plane(Color color) const
+{
+    return _planes[color == Color::WHITE];
+}
+
+#endif // BITBOARD_H
@@ -0,0 +1,371 @@
+/*! \file BitPlane.h
+ * BitPlane class definition
+ */
+
+#ifndef BITPLANE_H
+#define BITPLANE_H
+
+#include <array>
+#include <cstdint>
+
+/*!
+ * \brief A fixed-size set of 512 bits.
+ * A BitPlane holds one bit per cell of the largest board, so that a whole
+ * colour of a position fits in a single cache line.
+ */
+class BitPlane
+{
+public:
+    /*!
+     * \brief Number of 64-bit words of a plane
+     */
+    static const unsigned WORDS = 8;
+
+    /*!
+     * \brief Number of bits of a plane
+     */
+    static const unsigned BITS = WORDS * 64;
+
+private:
+    std::array<std::uint64_t, WORDS> _words;
+
+public:
+    /*!
+     * \brief Default BitPlane constructor. All bits are cleared.
+     */
+    BitPlane();
+
+    /*!
+     * \brief BitPlane constructor from its words
+     * \param words the 64-bit words, bit 0 of word 0 being bit 0 of the plane
+     */
+    explicit BitPlane(const std::array<std::uint64_t, WORDS> &words);
+
+    /*!
+     * \brief Check if the given bit is set
+     * \param bit the bit index
+     * \return `true` if the bit is set, `false` otherwise
+     */
+    bool test(unsigned bit) const;
+
+    /*!
+     * \brief Set the given bit
+     * \param bit the bit index
+     */
+    void set(unsigned bit);
+
+    /*!
+     * \brief Clear the given bit
+     * \param bit the bit index
+     */
+    void reset(unsigned bit);
+
+    /*!
+     * \brief Check if any bit is set
+     * \return `true` if at least one bit is set, `false` otherwise
+     */
+    bool any() const;
+
+    /*!
+     * \brief Return the number of set bits
+     * \return the number of set bits
+     */
+    unsigned count() const;
+
+    /*!
+     * \brief Return the given 64-bit word
+     * \param index the word index
+     * \return the word at the given index
+     */
+    std::uint64_t word(unsigned index) const;
+
+    /*!
+     * \brief Return all the 64-bit words
+     * \return the words of the plane
+     */
+    const std::array<std::uint64_t, WORDS> &words() const;
+
+    /*!
+     * \brief Bitwise AND assignment
+     * \param other the other plane
+     * \return this plane
+     */
+    BitPlane &operator&=(const BitPlane &other);
+
+    /*!
+     * \brief Bitwise OR assignment
+     * \param other the other plane
+     * \return this plane
+     */
+    BitPlane &operator|=(const BitPlane &other);
+
+    /*!
+     * \brief Bitwise XOR assignment
+     * \param other the other plane
+     * \return this plane
+     */
+    BitPlane &operator^=(const BitPlane &other);
+
+    /*!
+     * \brief Left shift assignment, towards the higher bits
+     * \param shift the number of bits to shift, less than BITS
+     * \return this plane
+     */
+    BitPlane &operator<<=(unsigned shift);
+
+    /*!
+     * \brief Right shift assignment, towards the lower bits
+     * \param shift the number of bits to shift, less than BITS
+     * \return this plane
+     */
+    BitPlane &operator>>=(unsigned shift);
+
+    /*!
+     * \brief Addition assignment, the plane being a 512-bit integer
+     * \param other the other plane
+     * \return this plane
+     */
+    BitPlane &operator+=(const BitPlane &other);
+
+    /*!
+     * \brief Bitwise NOT
+     * \return a plane where all the bits are flipped
+     */
+    BitPlane operator~() const;
+
+    /*!
+     * \brief Equality operator
+     * \param other the other plane
+     * \return `true` if both planes hold the same bits, `false` otherwise
+     */
+    bool operator==(const BitPlane &other) const;
+
+    /*!
+     * \brief Inequality operator
+     * \param other the other plane
+     * \return `true` if the planes differ, `false` otherwise
+     */
+    bool operator!=(const BitPlane &other) const;
+};
+
+/*!
+ * \brief Bitwise AND of two planes
+ * \param lhs the left operand
+ * \param rhs the right operand
+ * \return the bitwise AND of the two planes
+ */
+BitPlane operator&(BitPlane lhs, const BitPlane &rhs);
+
+/*!
+ * \brief Bitwise OR of two planes
+ * \param lhs the left operand
+ * \param rhs the right operand
+ * \return the bitwise OR of the two planes
+ */
+BitPlane operator|(BitPlane lhs, const BitPlane &rhs);
+
+/*!
+ * \brief Bitwise XOR of two planes
+ * \param lhs the left operand
+ * \param rhs the right operand
+ * \return the bitwise XOR of the two planes
+ */
+BitPlane operator^(BitPlane lhs, const BitPlane &rhs);
+
+/*!
+ * \brief Left shift of a plane
+ * \param lhs the plane
+ * \param shift the number of bits to shift, less than BitPlane::BITS
+ * \return the shifted plane
+ */
+BitPlane operator<<(BitPlane lhs, unsigned shift);
+
+/*!
+ * \brief Right shift of a plane
+ * \param lhs the plane
+ * \param shift the number of bits to shift, less than BitPlane::BITS
+ * \return the shifted plane
+ */
+BitPlane operator>>(BitPlane lhs, unsigned shift);
+
+/*!
+ * \brief Sum of two planes, as 512-bit integers
+ * \param lhs the left operand
+ * \param rhs the right operand
+ * \return the sum of the two planes
+ */
+BitPlane operator+(BitPlane lhs, const BitPlane &rhs);
+
+/* Bit operations are on the hot path of every move: keep them inline */
+
+inline BitPlane::BitPlane() :
+    _words()
+{ }
+
+inline BitPlane::BitPlane(const std::array<std::uint64_t, WORDS> &words) :
+    _words(words)
+{ }
+
+inline bool BitPlane::test(unsigned bit) const
+{
+    return (_words[bit / 64] >> (bit % 64)) & 1;
+}
+
+inline void BitPlane::set(unsigned bit)
+{
+    _words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+}
+
+inline void BitPlane::reset(unsigned bit)
+{
+    _words[bit / 64] &= ~(std::uint64_t(1) << (bit % 64));
+}
+
+inline bool BitPlane::any() const
+{
+    std::uint64_t any = 0;
+    for (unsigned i = 0; i < WORDS; i++) {
+        any |= _words[i];
+    }
+    return any != 0;
+}
+
+inline unsigned BitPlane::count() const
+{
+    unsigned count = 0;
+    for (unsigned i = 0; i < WORDS; i++) {
+        count += __builtin_popcountll(_words[i]);
+    }
+    return count;
+}
+
+inline std::uint64_t BitPlane::word(unsigned index) const
+{
+    return _words[index];
+}
+
+inline const std::array<std::uint64_t, BitPlane::WORDS> &BitPlane::words() const
+{
+    return _words;
+}
+
+inline BitPlane &BitPlane::operator&=(const BitPlane &other)
+{
+    for (unsigned i = 0; i < WORDS; i++) {
+        _words[i] &= other._words[i];
+    }
+    return *this;
+}
+
+inline BitPlane &BitPlane::operator|=(const BitPlane &other)
+{
+    for (unsigned i = 0; i < WORDS; i++) {
+        _words[i] |= other._words[i];
+    }
+    return *this;
+}
+
+inline BitPlane &BitPlane::operator^=(const BitPlane &other)
+{
+    for (unsigned i = 0; i < WORDS; i++) {
+        _words[i] ^= other._words[i];
+    }
+    return *this;
+}
+
+inline BitPlane &BitPlane::operator<<=(unsigned shift)
+{
+    unsigned words = shift / 64;
+    unsigned bits = shift % 64;
+
+    for (unsigned i = WORDS; i-- > words;) {
+        _words[i] = _words[i - words] << bits;
+        if (bits != 0 && i > words) {
+            _words[i] |= _words[i - words - 1] >> (64 - bits);
+        }
+    }
+    for (unsigned i = 0; i < words; i++) {
+        _words[i] = 0;
+    }
+    return *this;
+}
+
+inline BitPlane &BitPlane::operator>>=(unsigned shift)
+{
+    unsigned words = shift / 64;
+    unsigned bits = shift % 64;
+
+    for (unsigned i = 0; i + words < WORDS; i++) {
+        _words[i] = _words[i + words] >> bits;
+        if (bits != 0 && i + words + 1 < WORDS) {
+            _words[i] |= _words[i + words + 1] << (64 - bits);
+        }
+    }
+    for (unsigned i = WORDS - words; i < WORDS; i++) {
+        _words[i] = 0;
+    }
+    return *this;
+}
+
+inline BitPlane &BitPlane::operator+=(const BitPlane &other)
+{
+    std::uint64_t carry = 0;
+    for (unsigned i = 0; i < WORDS; i++) {
+        std::uint64_t sum = _words[i] + other._words[i];
+        std::uint64_t next = sum < _words[i];
+        _words[i] = sum + carry;
+        carry = next | (_words[i] < sum);
+    }
+    return *this;
+}
+
+inline BitPlane BitPlane::operator~() const
+{
+    BitPlane flipped;
+    for (unsigned i = 0; i < WORDS; i++) {
+        flipped._words[i] = ~_words[i];
+    }
+    return flipped;
+}
+
+inline bool BitPlane::operator==(const BitPlane &other) const
+{
+    return _words == other._words;
+}
+
+inline bool BitPlane::operator!=(const BitPlane &other) const
+{
+    return !(*this == other);
+}
+
+inline BitPlane operator&(BitPlane lhs, const BitPlane &rhs)
+{
+    return lhs &= rhs;
+}
+
+inline BitPlane operator|(BitPlane lhs, const BitPlane &rhs)
+{
+    return lhs |= rhs;
+}
+
+inline BitPlane operator^(BitPlane lhs, const BitPlane &rhs)
+{
+    return lhs ^= rhs;
+}
+
+inline BitPlane operator<<(BitPlane lhs, unsigned shift)
+{
+    return lhs <<= shift;
+}
+
+inline BitPlane operator>>(BitPlane lhs, unsigned shift)
+{
+    return lhs >>= shift;
+}
+
+inline BitPlane operator+(BitPlane lhs, const BitPlane &rhs)
+{
+    return lhs += rhs;
+}
+
+#endif // BITPLANE_H
@@ -0,0 +1,73 @@
+/*! \file BoardFactory.h
+ * Dispatch of board sizes to FixedBoard instantiations
+ */
+
+#ifndef BOARDFACTORY_H
+#define BOARDFACTORY_H
+
+#include "FixedBoard.h"
+#include "GenericBoard.h"
+
+/*!
+ * \brief Call a function with an empty board of the given size.
+ * Common sizes get a FixedBoard, the others a GenericBoard, so that the
+ * function is compiled once per instantiation and runs with the checks of
+ * its board unrolled. The function is an object with a templated call
+ * operator taking the board by reference:
+ *
+ *     struct Walk
+ *     {
+ *         template<typename Board>
+ *         void operator()(Board &board);
+ *     };
+ *
+ * The fixed sizes are the default 6x7 board with powers 3 to 5, and the 7x8
+ * board with powers 4 and 5.
+ * \param power number of pieces to align
+ * \param line number of lines of the board
+ * \param column number of columns of the board
+ * \param function the function to call
+ * \return `true` if a FixedBoard was used, `false` for a GenericBoard
+ * \throw std::out_of_range if the board exceeds BitBoard::MAX_LINE or
+ * BitBoard::MAX_COLUMN
+ */
+template<typename Function>
+bool dispatchBoard(unsigned power, unsigned line, unsigned column,
+                   Function &function)
+{
+    if (line == 6 && column == 7) {
+        if (power == 3) {
+            FixedBoard<3, 6, 7> board;
+            function(board);
+            return true;
+        }
+        if (power == 4) {
+            FixedBoard<4, 6, 7> board;
+            function(board);
+            return true;
+        }
+        if (power == 5) {
+            FixedBoard<5, 6, 7> board;
+            function(board);
+            return true;
+        }
+    }
+    if (line == 7 && column == 8) {
+        if (power == 4) {
+            FixedBoard<4, 7, 8> board;
+            function(board);
+            return true;
+        }
+        if (power == 5) {
+            FixedBoard<5, 7, 8> board;
+            function(board);
+            return true;
+        }
+    }
+
+    GenericBoard board(power, line, column);
+    function(board);
+    return false;
+}
+
+#endif // BOARDFACTORY_H
@@ -0,0 +1,119 @@
+#include <stdexcept>
+
+#include "BoardView.h"
+#include "ConnectN.h"
+#include "Zobrist.h"
+
+BoardView::BoardView(unsigned line, unsigned column) :
+    _line(line),
+    _column(column),
+    _text(),
+    _cells(0),
+    _moves(0),
+    _hash(0),
+    _first(Color::NONE)
+{
+    /* column indices, then a border line below each line of cells */
+    std::size_t indices = 4 * column + 1;
+    std::size_t border = 4 * column + 2;
+    std::size_t cells = 4 * column + 3;
+    _text.reserve(2 * indices + (line + 1) * border + line * cells);
+
+    std::string top;
+    for (unsigned i = 0; i < column; i++) {
+        top += ' ';
+        top += i < 10 ? ' ' : char('0' + i / 10);
+        top += char('0' + i % 10);
+        top += ' ';
+    }
+    top += '\n';
+    std::string separator;
+    for (unsigned i = 0; i < column * 4 + 1; i++) {
+        separator += i % 4 == 0 ? '|' : '-';
+    }
+    separator += '\n';
+
+    _text += top;
+    _text += separator;
+    _cells = _text.size();
+    for (unsigned i = 0; i < line; i++) {
+        _text += "| ";
+        for (unsigned j = 0; j < column; j++) {
+            _text += to_char(Color::NONE);
+            _text += " | ";
+        }
+        _text += '\n';
+        _text += separator;
+    }
+    _text += top;
+}
+
+/* Color of the player who moved first, NONE before the game starts */
+static Color firstColor(const ConnectN &game)
+{
+    const auto players = game.players();
+    bool firstActive = game.activePlayer() == players[0].first;
+    return players[firstActive == (game.movesPlayed() % 2 == 0) ? 0 : 1].second;
+}
+
+std::size_t BoardView::offset(unsigned line, unsigned column) const
+{
+    return _cells + line * (8 * _column + 5) + 2 + 4 * column;
+}
+
+void BoardView::draw(const ConnectN &game)
+{
+    const BitBoard &board = game.bitBoard();
+    for (unsigned line = 0; line < _line; line++) {
+        for (unsigned column = 0; column < _column; column++) {
+            _text[offset(line, column)] = to_char(board.cell(line, column));
+        }
+    }
+}
+
+unsigned BoardView::line() const
+{
+    return _line;
+}
+
+unsigned BoardView::column() const
+{
+    return _column;
+}
+
+const std::string &BoardView::render(const ConnectN &game)
+{
+    if (game.line() != _line || game.column() != _column) {
+        throw std::invalid_argument("Game size differs from the view");
+    }
+
+    unsigned moves = game.movesPlayed();
+    Color first = firstColor(game);
+    if (moves == _moves && game.hash() == _hash && first == _first) {
+        return _text;
+    }
+    if (moves == _moves + 1 && first == _first) {
+        /* the game is the previous one plus a piece if removing the piece
+         * gives back the previous hash */
+        const BitBoard &board = game.bitBoard();
+        unsigned column = game.move(moves - 1);
+        unsigned line = _line - board.height(column);
+        if ((game.hash() ^ Zobrist::key((moves - 1) % 2,
+                                        board.bit(line, column))) == _hash) {
+            _text[offset(line, column)] = to_char(board.cell(line, column));
+        } else {
+            draw(game);
+        }
+    } else {
+        draw(game);
+    }
+    _moves = moves;
+    _hash = game.hash();
+    _first = first;
+    return _text;
+}
+
+const std::string &BoardView::text() const
+{
+    return _text;
+}
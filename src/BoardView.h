@@ -0,0 +1,83 @@
+/*! \file BoardView.h
+ * BoardView class definition
+ */
+
+#ifndef BOARDVIEW_H
+#define BOARDVIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Color.h"
+
+class ConnectN;
+
+/*!
+ * \brief The text drawing of a board, kept up to date move after move.
+ * The frame of the board (column indices and borders) is laid out once in a
+ * string of the exact size of the drawing; rendering a game then only
+ * writes its cells in place. When the game has one more piece than at the
+ * previous rendering, and its first player has the same color, only the
+ * cell of that piece is written. The drawing is the one of
+ * operator<<(std::ostream &, const ConnectN &):
+ *
+ *       0   1   2
+ *     |---|---|---|
+ *     | X |   |   |
+ *     |---|---|---|
+ *       0   1   2
+ */
+class BoardView
+{
+private:
+    unsigned _line;
+    unsigned _column;
+    std::string _text;
+    std::size_t _cells;
+    unsigned _moves;
+    std::uint64_t _hash;
+    Color _first;
+
+    /* Offset of the given cell in the text */
+    std::size_t offset(unsigned line, unsigned column) const;
+
+    /* Write every cell of the game */
+    void draw(const ConnectN &game);
+
+public:
+    /*!
+     * \brief BoardView constructor. The board is drawn empty.
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     */
+    BoardView(unsigned line, unsigned column);
+
+    /*!
+     * \brief Return the number of lines
+     * \return the number of lines of the board
+     */
+    unsigned line() const;
+
+    /*!
+     * \brief Return the number of columns
+     * \return the number of columns of the board
+     */
+    unsigned column() const;
+
+    /*!
+     * \brief Draw a game
+     * \param game a game of the size of the view
+     * \return the drawing, valid until the next call
+     * \throw std::invalid_argument if the game size differs from the view
+     */
+    const std::string &render(const ConnectN &game);
+
+    /*!
+     * \brief Return the drawing of the last game rendered
+     * \return the drawing
+     */
+    const std::string &text() const;
+};
+
+#endif // BOARDVIEW_H
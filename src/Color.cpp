@@ -10,21 +10,20 @@ std::string to_string(Color color)
     return oss.str();
 }
 
-std::ostream &operator<<(std::ostream &out, Color in)
+char to_char(Color color)
 {
-    switch (in) {
+    switch (color) {
     case Color::BLACK:
-        out << "X";
-        break;
+        return 'X';
     case Color::WHITE:
-        out << "O";
-        break;
+        return 'O';
     case Color::NONE:
-        out << ' ';
-        break;
     default:
-        break;
+        return ' ';
     }
+}
 
-    return out;
+std::ostream &operator<<(std::ostream &out, Color in)
+{
+    return out << to_char(in);
 }
@@ -25,6 +25,13 @@ enum class Color {
  */
 std::string to_string(Color color);
 
+/*!
+ * \brief to_char
+ * \param color the color
+ * \return the character drawing the color: 'X', 'O' or ' '
+ */
+char to_char(Color color);
+
 /*!
  * \brief Color output stream operator
  * \param out the output stream
@@ -0,0 +1,24 @@
+#include <stdexcept>
+#include <utility>
+
+#include "ComputerPlayer.h"
+
+ComputerPlayer::ComputerPlayer(const std::string &name,
+                               std::unique_ptr<Engine> engine) :
+    Player(name),
+    _engine(std::move(engine))
+{
+    if (_engine == nullptr) {
+        throw std::invalid_argument("A computer player needs an engine");
+    }
+}
+
+unsigned ComputerPlayer::play(const ConnectN &game) const
+{
+    return _engine->bestMove(game);
+}
+
+Engine &ComputerPlayer::engine() const
+{
+    return *_engine;
+}
@@ -0,0 +1,45 @@
+/*! \file ComputerPlayer.h
+ * ComputerPlayer class definition
+ */
+
+#ifndef COMPUTERPLAYER_H
+#define COMPUTERPLAYER_H
+
+#include <memory>
+#include <string>
+
+#include "Player.h"
+#include "Engine.h"
+
+/*!
+ * \brief A ConnectN player whose moves are chosen by an engine
+ */
+class ComputerPlayer : public Player
+{
+private:
+    std::unique_ptr<Engine> _engine;
+
+public:
+    /*!
+     * \brief ComputerPlayer constructor
+     * \param name the name of the player
+     * \param engine the engine choosing the moves of the player
+     * \throw std::invalid_argument if engine is `nullptr`
+     */
+    ComputerPlayer(const std::string &name, std::unique_ptr<Engine> engine);
+
+    /*!
+     * \brief Choose the column where to play
+     * \param game a started, not finished game where the player is active
+     * \return a column where a piece can be dropped
+     */
+    unsigned play(const ConnectN &game) const;
+
+    /*!
+     * \brief Return the engine of the player
+     * \return the engine of the player
+     */
+    Engine &engine() const;
+};
+
+#endif // COMPUTERPLAYER_H
@@ -1,23 +1,33 @@
+#include <algorithm>
 #include <ostream>
-#include <iomanip>
-#include <sstream>
+#include "BoardView.h"
 #include "ConnectN.h"
-#include "libs/randomgenerator.hpp"
+#include "Zobrist.h"
 
 ConnectN::ConnectN() :
     ConnectN(DEFAULT_POWER, DEFAULT_LINE, DEFAULT_COLUMN)
 { }
 
 ConnectN::ConnectN(unsigned power, unsigned line, unsigned column) :
+    ConnectN(power, line, column, Random::randomSeed())
+{ }
+
+ConnectN::ConnectN(unsigned power, unsigned line, unsigned column,
+                   std::uint64_t seed) :
     _power(power),
     _line(line),
     _column(column),
     _started(false),
     _finished(false),
+    _moves(0),
+    _hash(0),
+    _mirrorHash(0),
     _winner(nullptr),
     _activePlayer(nullptr),
     _players{{{ nullptr, Color::NONE }, { nullptr, Color::NONE }}},
-    _board{line, std::vector<Color>{column, Color::NONE}}
+    _board(line, column),
+    _history(),
+    _random(seed)
 {
     if (power < MIN_POWER || power > MAX_POWER) {
         throw std::out_of_range("Power must be comprised between 3 and 10");
@@ -28,6 +38,31 @@ ConnectN::ConnectN(unsigned power, unsigned line, unsigned column) :
     }
 }
 
+ConnectN::ConnectN(const Position &position, const Player *first,
+                   const Player *second) :
+    _power(position.power),
+    _line(position.board.line()),
+    _column(position.board.column()),
+    _started(true),
+    _finished(position.finished),
+    _moves(position.moves),
+    _hash(position.hash),
+    _mirrorHash(position.mirrorHash),
+    _winner(position.winner == 0 ? nullptr
+                                 : position.winner == 1 ? first : second),
+    _activePlayer(position.active == 0 ? first : second),
+    _players{{{ first, position.color },
+              { second, position.color == Color::BLACK ? Color::WHITE
+                                                       : Color::BLACK }}},
+    _board(position.board),
+    _history(position.history),
+    _random(0)
+{
+    if (first == second) {
+        throw std::invalid_argument("Player is already enrolled");
+    }
+}
+
 void ConnectN::enroll(const Player *player)
 {
     if (_players[0].first == nullptr) {
@@ -37,7 +72,7 @@ void ConnectN::enroll(const Player *player)
             throw std::invalid_argument("Player is already enrolled");
         } else {
             _players[1].first = player;
-            if (nvs::random_integer(0, 1)) {
+            if (_random.below(2)) {
                 _players[0].second = Color::WHITE;
                 _players[1].second = Color::BLACK;
             } else {
@@ -45,55 +80,130 @@ void ConnectN::enroll(const Player *player)
                 _players[1].second = Color::WHITE;
             }
             _started = true;
-            _activePlayer = _players[nvs::random_integer(0, 1)].first;
+            _activePlayer = _players[_random.below(2)].first;
         }
     } else {
         throw std::logic_error("Too much players");
     }
 }
 
+void ConnectN::enroll(const Player *first, const Player *second,
+                      Color color, unsigned active)
+{
+    if (_players[0].first != nullptr) {
+        throw std::logic_error("Too much players");
+    }
+    if (first == second) {
+        throw std::invalid_argument("Player is already enrolled");
+    }
+    if (color == Color::NONE || active > 1) {
+        throw std::invalid_argument("Bad color or first player");
+    }
+    _players[0] = std::make_pair(first, color);
+    _players[1] = std::make_pair(second, color == Color::BLACK ? Color::WHITE
+                                                               : Color::BLACK);
+    _started = true;
+    _activePlayer = _players[active].first;
+}
+
 void ConnectN::play(unsigned column)
+{
+    switch (tryPlay(column)) {
+    case MoveStatus::NOT_STARTED:
+        throw std::logic_error("Game not yet started");
+    case MoveStatus::FINISHED:
+        throw std::logic_error("Game already finished");
+    case MoveStatus::OUT_OF_BOARD:
+    case MoveStatus::FULL:
+        throw std::out_of_range("Can't play here");
+    case MoveStatus::PLAYED:
+    default:
+        break;
+    }
+}
+
+ConnectN::MoveStatus ConnectN::tryPlay(unsigned column)
 {
     int line;
     if (!started()) {
-        throw std::logic_error("Game not yet started");
+        return MoveStatus::NOT_STARTED;
     }
     if (finished()) {
-        throw std::logic_error("Game already finished");
+        return MoveStatus::FINISHED;
+    }
+    if (column >= _column) {
+        return MoveStatus::OUT_OF_BOARD;
     }
     Color activeColor = color(activePlayer());
-    if ((line = dropPiece(column, activeColor)) != -1) {
-        if (horizontallyAligned(line, activeColor)
-                || verticallyAligned(column, activeColor)
-                || diagonallyAlignedBRUL(line, column, activeColor)
-                || diagonallyAlignedBLUR(line, column, activeColor)) {
-            _winner = _activePlayer;
-            _finished = true;
-        } else if (boardIsFull()) {
-            _finished = true;
+    if ((line = dropPiece(column, activeColor)) == -1) {
+        return MoveStatus::FULL;
+    }
+    _history[_moves++] = column;
+    if (horizontallyAligned(line, column, activeColor)
+            || verticallyAligned(line, column, activeColor)
+            || diagonallyAlignedBRUL(line, column, activeColor)
+            || diagonallyAlignedBLUR(line, column, activeColor)) {
+        _winner = _activePlayer;
+        _finished = true;
+    } else if (boardIsFull()) {
+        _finished = true;
+    }
+    switchActivePlayer();
+    return MoveStatus::PLAYED;
+}
+
+std::uint32_t ConnectN::legalMoves() const
+{
+    std::uint32_t moves = 0;
+    if (!started() || finished()) {
+        return moves;
+    }
+    for (unsigned column = 0; column < _column; column++) {
+        if (_board.playable(column)) {
+            moves |= std::uint32_t(1) << column;
         }
-        switchActivePlayer();
-    } else {
-        throw std::out_of_range("Can't play here");
     }
+    return moves;
+}
+
+void ConnectN::undo()
+{
+    if (_moves == 0) {
+        throw std::logic_error("No move to undo");
+    }
+    unsigned column = _history[--_moves];
+    unsigned line = _board.remove(column);
+    _hash ^= Zobrist::key(_moves % 2, _board.bit(line, column));
+    _mirrorHash ^= Zobrist::key(_moves % 2, _board.bit(line, mirror(column)));
+    /* no move can be played once the game is finished, so the game was
+     * running before the last move
+     */
+    _finished = false;
+    _winner = nullptr;
+    switchActivePlayer();
+}
+
+bool ConnectN::winningMove(unsigned column, Color color) const
+{
+    if (!_board.playable(column)) {
+        return false;
+    }
+    /* the checks only look at the neighbours of the cell */
+    unsigned line = _line - 1 - _board.height(column);
+    return horizontallyAligned(line, column, color)
+            || verticallyAligned(line, column, color)
+            || diagonallyAlignedBRUL(line, column, color)
+            || diagonallyAlignedBLUR(line, column, color);
 }
 
 int ConnectN::dropPiece(unsigned column, Color color)
 {
     int lineDropped = -1;
-    bool added = false;
-    if (column < _column) {
-        unsigned line = _line;
-        Color *cell;
-        while (line > 0 && !added) {
-            cell = &_board.at(line - 1).at(column);
-            if (*cell == Color::NONE) {
-                *cell = color;
-                lineDropped = line - 1;
-                added = true;
-            }
-            line--;
-        }
+    if (_board.playable(column)) {
+        lineDropped = _board.drop(column, color);
+        _hash ^= Zobrist::key(_moves % 2, _board.bit(lineDropped, column));
+        _mirrorHash ^= Zobrist::key(_moves % 2,
+                                    _board.bit(lineDropped, mirror(column)));
     }
 
     return lineDropped;
@@ -108,154 +218,123 @@ void ConnectN::switchActivePlayer()
     }
 }
 
-bool ConnectN::horizontallyAligned(unsigned line, Color color)
-{
-    bool found = false;
-    unsigned counter = 0;
-    unsigned currentColumn = 0;
+/* Only the cells at most _power - 1 away from the last dropped piece can
+ * complete an alignment with it, so each check counts the pieces of the same
+ * color on both sides of that piece.
+ */
 
-    while (!found && currentColumn < _column) {
-        if (_board.at(line).at(currentColumn) == color) {
-            counter++;
-        } else {
-            counter = 0;
-        }
-        if (counter == _power) {
-            found = true;
-        }
-        currentColumn++;
-    }
+bool ConnectN::horizontallyAligned(unsigned line, unsigned column, Color color) const
+{
+    return 1 + _board.run(line, column, 0, -1, color, _power - 1)
+            + _board.run(line, column, 0, 1, color, _power - 1) >= _power;
+}
 
-    return found;
+bool ConnectN::verticallyAligned(unsigned line, unsigned column, Color color) const
+{
+    /* the last dropped piece is the top of its column */
+    return 1 + _board.run(line, column, 1, 0, color, _power - 1) >= _power;
 }
 
-bool ConnectN::verticallyAligned(unsigned column, Color color)
+bool ConnectN::diagonallyAlignedBRUL(unsigned line, unsigned column, Color color) const
 {
-    bool found = false;
-    unsigned counter = 0;
-    int currentLine = _line - 1;
+    return 1 + _board.run(line, column, 1, 1, color, _power - 1)
+            + _board.run(line, column, -1, -1, color, _power - 1) >= _power;
+}
 
-    while (!found && currentLine >= 0) {
-        if (_board.at(currentLine).at(column) == color) {
-            counter++;
-        } else {
-            counter = 0;
-        }
-        if (counter == _power) {
-            found = true;
-        }
-        currentLine--;
-    }
+bool ConnectN::diagonallyAlignedBLUR(unsigned line, unsigned column, Color color) const
+{
+    return 1 + _board.run(line, column, 1, -1, color, _power - 1)
+            + _board.run(line, column, -1, 1, color, _power - 1) >= _power;
+}
 
-    return found;
+bool ConnectN::boardIsFull() const
+{
+    return _moves == _line * _column;
 }
 
-bool ConnectN::diagonallyAlignedBRUL(unsigned line, unsigned column, Color color)
+unsigned ConnectN::power() const
 {
-    bool found = false;
-    unsigned counter = 0;
-    int currentLine = line;
-    int currentColumn = column;
+    return _power;
+}
 
-    /* go to the bottom-right cell of the diagonal */
-    while ((currentLine < _line - 1) && (currentColumn < _column - 1)) {
-        currentLine++;
-        currentColumn++;
-    }
+unsigned ConnectN::line() const
+{
+    return _line;
+}
 
-    /* go back up to the upper-left cell by checking if there are N aligned
-     * pieces
-     */
-    while (!found && currentLine >= 0 && currentColumn >= 0) {
-        if (_board.at(currentLine).at(currentColumn) == color) {
-            counter++;
-            if (counter == _power) {
-                found = true;
-            }
-        } else {
-            counter = 0;
-        }
-        currentLine--;
-        currentColumn--;
-    }
+unsigned ConnectN::column() const
+{
+    return _column;
+}
 
-    return found;
+bool ConnectN::started() const
+{
+    return _started;
 }
 
-bool ConnectN::diagonallyAlignedBLUR(unsigned line, unsigned column, Color color)
+bool ConnectN::finished() const
 {
-    bool found = false;
-    unsigned counter = 0;
-    int currentLine = line;
-    int currentColumn = column;
+    return _finished;
+}
 
-    /* go to the bottom-left cell of the diagonal */
-    while ((currentLine < _line - 1) && (currentColumn >= 0)) {
-        currentLine++;
-        currentColumn--;
-    }
+unsigned ConnectN::movesPlayed() const
+{
+    return _moves;
+}
 
-    /* go back up to the upper-right cell by checking if there are N aligned
-     * pieces
-     */
-    while (!found && currentLine >= 0 && currentColumn < _column) {
-        if (_board.at(currentLine).at(currentColumn) == color) {
-            counter++;
-            if (counter == _power) {
-                found = true;
-            }
-        } else {
-            counter = 0;
-        }
-        currentLine--;
-        currentColumn++;
+unsigned ConnectN::move(unsigned index) const
+{
+    if (index >= _moves) {
+        throw std::out_of_range("No such move");
     }
-
-    return found;
+    return _history[index];
 }
 
-bool ConnectN::boardIsFull()
+Position ConnectN::position() const
 {
-    bool isFull = true;
-    unsigned line = 0;
-    unsigned column = 0;
-
-    while (isFull && line < _line) {
-        while (isFull && column < _column) {
-            if (_board.at(line).at(column) == Color::NONE) {
-                isFull = false;
-            }
-            column++;
-        }
-        line++;
+    if (!started()) {
+        throw std::logic_error("Game not yet started");
     }
 
-    return isFull;
+    Position position;
+    position.board = _board;
+    position.hash = _hash;
+    position.mirrorHash = _mirrorHash;
+    std::copy(_history.begin(), _history.begin() + _moves,
+              position.history.begin());
+    position.moves = _moves;
+    position.power = _power;
+    position.color = _players[0].second;
+    position.active = _activePlayer == _players[0].first ? 0 : 1;
+    position.winner = _winner == nullptr ? 0
+                                         : _winner == _players[0].first ? 1 : 2;
+    position.finished = _finished;
+    return position;
 }
 
-unsigned ConnectN::power() const
+std::uint64_t ConnectN::hash() const
 {
-    return _power;
+    return _hash;
 }
 
-unsigned ConnectN::line() const
+std::uint64_t ConnectN::mirrorHash() const
 {
-    return _line;
+    return _mirrorHash;
 }
 
-unsigned ConnectN::column() const
+std::uint64_t ConnectN::canonicalHash() const
 {
-    return _column;
+    return std::min(_hash, _mirrorHash);
 }
 
-bool ConnectN::started() const
+bool ConnectN::mirrored() const
 {
-    return _started;
+    return _mirrorHash < _hash;
 }
 
-bool ConnectN::finished() const
+unsigned ConnectN::mirror(unsigned column) const
 {
-    return _finished;
+    return _column - 1 - column;
 }
 
 const Player * ConnectN::winner() const
@@ -284,54 +363,33 @@ Color ConnectN::color(const Player *player) const
     }
 }
 
-const std::vector<std::vector<Color>> &ConnectN::board() const
+Color ConnectN::cell(unsigned line, unsigned column) const
 {
-    return _board;
+    if (line >= _line || column >= _column) {
+        throw std::out_of_range("Cell out of the board");
+    }
+    return _board.cell(line, column);
 }
 
-std::string to_string(const ConnectN &game)
+std::vector<std::vector<Color>> ConnectN::board() const
 {
-    std::ostringstream oss;
-    oss << game;
-    return oss.str();
+    return _board.lines();
 }
 
-std::ostream &operator<<(std::ostream &out, ConnectN in) {
-    /* Top indices */
-    for (unsigned column = 0; column < in.column(); column++) {
-        out << std::setw(3) << column << ' ';
-    }
-    out << std::endl;
-
-    /* Board */
-    for (unsigned i = 0; i < in.column() * 4 + 1; i++) {
-        if (i % 4 == 0)
-            out << '|';
-        else
-            out << '-';
-    }
-    out << std::endl;
-
-    for (auto line : in.board()) {
-        out << "| ";
-        for (auto cell : line) {
-            out << cell << " | ";
-        }
-        out << std::endl;
-        for (unsigned i = 0; i < in.column() * 4 + 1; i++) {
-            if (i % 4 == 0)
-                out << '|';
-            else
-                out << '-';
-        }
-        out << std::endl;
-    }
+const BitBoard &ConnectN::bitBoard() const
+{
+    return _board;
+}
 
-    /* Bottom indices */
-    for (unsigned column = 0; column < in.column(); column++) {
-        out << std::setw(3) << column << ' ';
-    }
-    out << std::endl;
+std::string to_string(const ConnectN &game)
+{
+    BoardView view(game.line(), game.column());
+    return view.render(game);
+}
 
-    return out;
+std::ostream &operator<<(std::ostream &out, const ConnectN &in)
+{
+    BoardView view(in.line(), in.column());
+    const std::string &text = view.render(in);
+    return out.write(text.data(), text.size());
 }
@@ -7,11 +7,15 @@
 
 #include <vector>
 #include <array>
+#include <cstdint>
 #include <string>
 #include <sstream>
 
 #include "Player.h"
 #include "Color.h"
+#include "BitBoard.h"
+#include "Position.h"
+#include "Random.h"
 
 /*!
  * \brief The ConnectN game
@@ -24,10 +28,15 @@ private:
     unsigned _column;
     bool _started;
     bool _finished;
+    unsigned _moves;
+    std::uint64_t _hash;
+    std::uint64_t _mirrorHash;
     const Player *_winner;
     const Player *_activePlayer;
     std::array<std::pair<const Player *, Color>, 2> _players;
-    std::vector<std::vector<Color>> _board;
+    BitBoard _board;
+    std::array<unsigned char, BitBoard::MAX_LINE * BitBoard::MAX_COLUMN> _history;
+    Random _random;
 
     /* Drop piece in the given column */
     int dropPiece(unsigned column, Color color);
@@ -35,20 +44,22 @@ private:
     /* Switch active player */
     void switchActivePlayer();
 
-    /* Check if horizontally aligned */
-    bool horizontallyAligned(unsigned line, Color color);
+    /* Check if the piece at the given cell is horizontally aligned */
+    bool horizontallyAligned(unsigned line, unsigned column, Color color) const;
 
-    /* Check if vertically aligned */
-    bool verticallyAligned(unsigned column, Color color);
+    /* Check if the piece at the given cell is vertically aligned */
+    bool verticallyAligned(unsigned line, unsigned column, Color color) const;
 
-    /* Check if aligned in bottom-right to upper-left diagonal: \ */
-    bool diagonallyAlignedBRUL(unsigned line, unsigned column, Color color);
+    /* Check if the piece at the given cell is aligned in bottom-right to
+     * upper-left diagonal: \ */
+    bool diagonallyAlignedBRUL(unsigned line, unsigned column, Color color) const;
 
-    /* Check if aligned in bottom-left to upper-right diagonal: / */
-    bool diagonallyAlignedBLUR(unsigned line, unsigned column, Color color);
+    /* Check if the piece at the given cell is aligned in bottom-left to
+     * upper-right diagonal: / */
+    bool diagonallyAlignedBLUR(unsigned line, unsigned column, Color color) const;
 
     /* Check if board is full */
-    bool boardIsFull();
+    bool boardIsFull() const;
 
 public:
     enum {
@@ -77,6 +88,23 @@ public:
      */
     static const unsigned DELTA_COLUMN = MAX_POWER + 10;
 
+    static_assert(DELTA_LINE <= BitBoard::MAX_LINE
+                  && DELTA_COLUMN <= BitBoard::MAX_COLUMN,
+                  "BitBoard must hold the largest board");
+    static_assert(DELTA_COLUMN <= 32,
+                  "legalMoves() must hold a bit per column");
+
+    /*!
+     * \brief The outcome of tryPlay()
+     */
+    enum class MoveStatus {
+        PLAYED, /*!< the piece was dropped */
+        NOT_STARTED, /*!< the game is not started */
+        FINISHED, /*!< the game is finished */
+        OUT_OF_BOARD, /*!< the column is out of the board */
+        FULL /*!< the column is full */
+    };
+
     /*!
      * \brief Default ConnectN constructor.
      * DEFAULT_POWER, DEFAULT_LINE and DEFAULT_COLUMN are used as default
@@ -85,13 +113,36 @@ public:
     ConnectN();
 
     /*!
-     * \brief Custom ConnectN constructor
+     * \brief Custom ConnectN constructor.
+     * Colors and the first player are drawn from a random seed.
      * \param power number of pieces to align
      * \param line number of lines of the board
      * \param column number of columns of the board
      */
     ConnectN (unsigned power, unsigned line, unsigned column);
 
+    /*!
+     * \brief Seeded ConnectN constructor.
+     * Colors and the first player are drawn from the given seed, so that the
+     * same seed always gives the same game.
+     * \param power number of pieces to align
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     * \param seed the seed of the random generator of the game
+     */
+    ConnectN (unsigned power, unsigned line, unsigned column,
+              std::uint64_t seed);
+
+    /*!
+     * \brief Position constructor. The game goes on from a position.
+     * \param position a position made by position()
+     * \param first the player at index 0 of the position, players()[0]
+     * \param second the player at index 1, players()[1]
+     * \throw std::invalid_argument if the players are the same
+     */
+    ConnectN(const Position &position, const Player *first,
+             const Player *second);
+
     /*!
      * \brief Enroll a player
      * \param player the player to enroll
@@ -100,6 +151,20 @@ public:
      */
     void enroll(const Player *player);
 
+    /*!
+     * \brief Enroll two players with the given colors and first player,
+     * rather than drawn ones, such as to replay a recorded game
+     * \param first the first player, players()[0]
+     * \param second the second player, players()[1]
+     * \param color the color of the first player, BLACK or WHITE
+     * \param active the index in players() of the player who moves first
+     * \throw std::invalid_argument if the players are the same, if color is
+     * NONE or if active is neither 0 nor 1
+     * \throw std::logic_error if a player is already enrolled
+     */
+    void enroll(const Player *first, const Player *second, Color color,
+                unsigned active);
+
     /*!
      * \brief Play at the given column.
      * This method tries to drop a piece in the column given as parameter. If it
@@ -116,6 +181,43 @@ public:
      */
     void play(unsigned column);
 
+    /*!
+     * \brief Play at the given column, as play() does, without throwing.
+     * An illegal move leaves the game untouched and is reported by the
+     * status, so that simulations and untrusted input can try moves at no
+     * more cost than legal ones.
+     * \param column the column where to play
+     * \return MoveStatus::PLAYED if the piece was dropped, the reason why
+     * not otherwise
+     */
+    MoveStatus tryPlay(unsigned column);
+
+    /*!
+     * \brief Return the columns where the active player can play
+     * \return a mask where bit i is set if column i can be played; 0 if the
+     * game is not started or is finished
+     */
+    std::uint32_t legalMoves() const;
+
+    /*!
+     * \brief Take back the last piece played.
+     * The board, the active player and the winner are restored as they were
+     * before the last call to play(). If the game was finished by that move,
+     * it is not finished anymore.
+     * \throw std::logic_error if no piece has been played
+     */
+    void undo();
+
+    /*!
+     * \brief Check if a piece dropped in the given column would win.
+     * The board is left untouched.
+     * \param column the column where the piece would be dropped
+     * \param color the color of the piece
+     * \return `true` if the piece would complete an alignment, `false` if
+     * not or if the column is full or out of the board
+     */
+    bool winningMove(unsigned column, Color color) const;
+
     /*!
      * \brief Return the number of pieces to align
      * \return the number of pieces to align
@@ -148,6 +250,65 @@ public:
      */
     bool finished() const;
 
+    /*!
+     * \brief Return the number of pieces played since the game started
+     * \return the number of pieces played
+     */
+    unsigned movesPlayed() const;
+
+    /*!
+     * \brief Return a move played
+     * \param index the index of the move, 0 for the first one
+     * \return the column of the move
+     * \throw std::out_of_range if index is not less than movesPlayed()
+     */
+    unsigned move(unsigned index) const;
+
+    /*!
+     * \brief Return the state of the game as a plain value
+     * \return the position of the game
+     * \throw std::logic_error if the game is not started
+     */
+    Position position() const;
+
+    /*!
+     * \brief Return the Zobrist hash of the board.
+     * The hash only depends on which cells were filled by the player who
+     * moved first and by the other player, see Zobrist.
+     * \return the hash of the board
+     */
+    std::uint64_t hash() const;
+
+    /*!
+     * \brief Return the Zobrist hash of the mirrored board, the board seen
+     * with its columns in reverse order. It is kept up to date along with
+     * hash(), at the cost of one more XOR per move.
+     * \return the hash of the mirrored board
+     */
+    std::uint64_t mirrorHash() const;
+
+    /*!
+     * \brief Return the hash of the canonical form of the board: the board
+     * or its mirror, whichever has the smaller hash. A position and its
+     * mirror have the same canonical hash.
+     * \return the smaller of hash() and mirrorHash()
+     */
+    std::uint64_t canonicalHash() const;
+
+    /*!
+     * \brief Check if the canonical form of the board is its mirror
+     * \return `true` if mirrorHash() is less than hash(); the columns of the
+     * canonical form are then mirrored, see mirror()
+     */
+    bool mirrored() const;
+
+    /*!
+     * \brief Return the column matching the given one on the mirrored board
+     * \param column a column of the board
+     * \return column() - 1 - column
+     */
+    unsigned mirror(unsigned column) const;
+
     /*!
      * \brief Return the winner
      * \return the winner if any, `nullptr` otherwise
@@ -173,10 +334,25 @@ public:
     Color color(const Player *) const;
 
     /*!
-     * \brief Return the game board
-     * \return the game board
+     * \brief Return the color of the given cell
+     * \param line the line of the cell, 0 being the top line
+     * \param column the column of the cell
+     * \return the color of the piece in the cell, Color::NONE if empty
+     * \throw std::out_of_range if the cell is out of the board
+     */
+    Color cell(unsigned line, unsigned column) const;
+
+    /*!
+     * \brief Return a view of the game board as a vector of lines
+     * \return the game board, line 0 being the top line
+     */
+    std::vector<std::vector<Color>> board() const;
+
+    /*!
+     * \brief Return the packed game board
+     * \return the packed game board
      */
-    const std::vector<std::vector<Color>> &board() const;
+    const BitBoard &bitBoard() const;
 };
 
 /*!
@@ -187,11 +363,12 @@ public:
 std::string to_string(const ConnectN &game);
 
 /*!
- * \brief ConnectN output stream operator
+ * \brief ConnectN output stream operator.
+ * The board is drawn by a BoardView, in a single write.
  * \param out the output stream
  * \param in the ConnectN game
  * \return the string representation of the ConnectN game
  */
-std::ostream &operator<<(std::ostream &out, ConnectN in);
+std::ostream &operator<<(std::ostream &out, const ConnectN &in);
 
 #endif // CONNECTN_H
@@ -0,0 +1,4 @@
+#include "Engine.h"
+
+Engine::~Engine()
+{ }
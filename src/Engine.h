@@ -0,0 +1,29 @@
+/*! \file Engine.h
+ * Engine class definition
+ */
+
+#ifndef ENGINE_H
+#define ENGINE_H
+
+class ConnectN;
+
+/*!
+ * \brief A strategy choosing where to play in a ConnectN game
+ */
+class Engine
+{
+public:
+    /*!
+     * \brief Engine destructor
+     */
+    virtual ~Engine();
+
+    /*!
+     * \brief Choose the column where the active player should play.
+     * \param game a started, not finished game
+     * \return a column where a piece can be dropped
+     */
+    virtual unsigned bestMove(const ConnectN &game) = 0;
+};
+
+#endif // ENGINE_H
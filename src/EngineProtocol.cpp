@@ -0,0 +1,195 @@
+#include <sstream>
+#include <stdexcept>
+
+#include "EngineProtocol.h"
+#include "libs/stringConvert.hpp"
+
+/* Read the number following a keyword */
+static unsigned number(std::istream &in, const std::string &keyword)
+{
+    std::string word;
+    if (!(in >> word)) {
+        throw std::invalid_argument("Missing number after " + keyword);
+    }
+    return nvs::fromString<unsigned>(word);
+}
+
+EngineProtocol::EngineProtocol(Output output,
+                               std::shared_ptr<TranspositionTable> table,
+                               unsigned threads) :
+    _output(output),
+    _outputMutex(),
+    _first("first"),
+    _second("second"),
+    _game(startGame(ConnectN::DEFAULT_POWER, ConnectN::DEFAULT_LINE,
+                    ConnectN::DEFAULT_COLUMN)),
+    _search(Negamax::DEFAULT_DEPTH, table, threads),
+    _thread(),
+    _searching(false)
+{ }
+
+EngineProtocol::~EngineProtocol()
+{
+    stopSearch();
+}
+
+void EngineProtocol::send(const std::string &line)
+{
+    std::lock_guard<std::mutex> lock(_outputMutex);
+    _output(line);
+}
+
+ConnectN EngineProtocol::startGame(unsigned power, unsigned line,
+                                   unsigned column)
+{
+    /* colors and the first player do not matter to the engine */
+    ConnectN game(power, line, column, 0);
+    game.enroll(&_first, &_second, Color::BLACK, 0);
+    return game;
+}
+
+void EngineProtocol::stopSearch()
+{
+    if (_thread.joinable()) {
+        _search.stop();
+        _thread.join();
+    }
+}
+
+void EngineProtocol::go(std::istream &arguments)
+{
+    if (_searching) {
+        throw std::logic_error("Search in progress");
+    }
+    if (_game.finished()) {
+        throw std::logic_error("Game is over");
+    }
+
+    unsigned depth = 0;
+    unsigned budget = 0;
+    bool infinite = false;
+    std::string word;
+    while (arguments >> word) {
+        if (word == "depth") {
+            depth = number(arguments, word);
+        } else if (word == "movetime") {
+            budget = number(arguments, word);
+        } else if (word == "infinite") {
+            infinite = true;
+        } else {
+            throw std::invalid_argument("Unknown go argument " + word);
+        }
+    }
+    if (depth == 0) {
+        /* the search stops at the end of the game anyway */
+        depth = budget > 0 || infinite ? _game.line() * _game.column()
+                                       : Negamax::DEFAULT_DEPTH;
+    }
+
+    /* the previous search has ended, its thread may still be sending */
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+    _search.depth(depth);
+    _search.budget(infinite ? 0 : budget);
+    _search.resume();
+    _searching = true;
+    ConnectN game = _game;
+    _thread = std::thread([this, game]() {
+        unsigned move = _search.bestMove(game);
+        const SearchStats &stats = _search.stats();
+        std::ostringstream info;
+        if (stats.book) {
+            info << "info book";
+        } else {
+            info << "info depth " << stats.depth << " nodes " << stats.nodes
+                 << " time " << unsigned(stats.seconds * 1000);
+        }
+        _searching = false;
+        send(info.str());
+        send("bestmove " + std::to_string(move));
+    });
+}
+
+bool EngineProtocol::execute(const std::string &command)
+{
+    std::istringstream in(command);
+    std::string name;
+    if (!(in >> name)) {
+        return true;
+    }
+
+    try {
+        if (name == "uci") {
+            send("id name ConnectN");
+            send("uciok");
+        } else if (name == "isready") {
+            send("readyok");
+        } else if (name == "newgame") {
+            unsigned power = ConnectN::DEFAULT_POWER;
+            unsigned line = ConnectN::DEFAULT_LINE;
+            unsigned column = ConnectN::DEFAULT_COLUMN;
+            std::string word;
+            if (in >> word) {
+                power = nvs::fromString<unsigned>(word);
+                line = number(in, "power");
+                column = number(in, "lines");
+            }
+            ConnectN game = startGame(power, line, column);
+            stopSearch();
+            /* the entries of another board size or power would be wrong */
+            if (_search.table() != nullptr && (power != _game.power()
+                                               || line != _game.line()
+                                               || column != _game.column())) {
+                _search.table()->clear();
+            }
+            _game = game;
+        } else if (name == "position") {
+            ConnectN game = startGame(_game.power(), _game.line(),
+                                      _game.column());
+            std::string word;
+            in >> word;
+            if (word == "startpos") {
+                word.clear();
+                in >> word;
+            }
+            if (word == "moves") {
+                while (in >> word) {
+                    if (game.tryPlay(nvs::fromString<unsigned>(word))
+                            != ConnectN::MoveStatus::PLAYED) {
+                        throw std::invalid_argument("Illegal move " + word);
+                    }
+                }
+            } else if (!word.empty()) {
+                throw std::invalid_argument("Unknown position argument "
+                                            + word);
+            }
+            stopSearch();
+            _game = game;
+        } else if (name == "go") {
+            go(in);
+        } else if (name == "stop") {
+            stopSearch();
+        } else if (name == "quit") {
+            stopSearch();
+            return false;
+        } else {
+            throw std::invalid_argument("Unknown command " + name);
+        }
+    } catch (const nvs::bad_string_convert &) {
+        send("error Invalid number");
+    } catch (const std::exception &e) {
+        send(std::string("error ") + e.what());
+    }
+    return true;
+}
+
+bool EngineProtocol::searching() const
+{
+    return _searching;
+}
+
+Negamax &EngineProtocol::search()
+{
+    return _search;
+}
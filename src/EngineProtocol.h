@@ -0,0 +1,119 @@
+/*! \file EngineProtocol.h
+ * EngineProtocol class definition
+ */
+
+#ifndef ENGINEPROTOCOL_H
+#define ENGINEPROTOCOL_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "ConnectN.h"
+#include "Negamax.h"
+#include "Player.h"
+#include "TranspositionTable.h"
+
+/*!
+ * \brief A line-based engine protocol, in the spirit of UCI.
+ * Each command is one line of words separated by spaces; answers are lines
+ * given to an output function, possibly from the search thread:
+ *
+ *     uci                      id name ConnectN, then uciok
+ *     isready                  readyok, even while searching
+ *     newgame [P L C]          start an empty board, the default one
+ *                              without arguments
+ *     position [startpos] [moves C...]
+ *                              set the position: the empty board, then
+ *                              the given columns
+ *     go [depth D] [movetime MS] [infinite]
+ *                              search the position in the background; a
+ *                              movetime without depth searches as deep as
+ *                              the time allows, infinite until stop
+ *     stop                     stop the search
+ *     quit                     stop the search and end the session
+ *
+ * A search ends with `info depth D nodes N time MS`, or `info book` for a
+ * move of the opening book, then `bestmove C`. A stop, a new game or a new
+ * position stops the search in progress first, so that its bestmove is sent
+ * before the command returns. Invalid commands are answered by `error`
+ * followed by the reason.
+ */
+class EngineProtocol
+{
+public:
+    /*!
+     * \brief A function sending one line, without its end of line
+     */
+    typedef std::function<void(const std::string &)> Output;
+
+private:
+    Output _output;
+    std::mutex _outputMutex;
+    Player _first;
+    Player _second;
+    ConnectN _game;
+    Negamax _search;
+    std::thread _thread;
+    std::atomic<bool> _searching;
+
+    /* Send a line through the output function */
+    void send(const std::string &line);
+
+    /* Start an empty game of the given size */
+    ConnectN startGame(unsigned power, unsigned line, unsigned column);
+
+    /* Stop the search in progress, if any, and wait for its bestmove */
+    void stopSearch();
+
+    /* Start searching the current game in the background */
+    void go(std::istream &arguments);
+
+public:
+    /*!
+     * \brief EngineProtocol constructor. The game starts on the default
+     * board.
+     * \param output the function sending the answers; it is called from the
+     * thread executing the commands and from the search thread, never from
+     * both at once
+     * \param table the transposition table of the searches, if any
+     * \param threads number of search threads
+     * \throw std::out_of_range if threads is 0
+     */
+    EngineProtocol(Output output,
+                   std::shared_ptr<TranspositionTable> table = nullptr,
+                   unsigned threads = 1);
+
+    /*!
+     * \brief EngineProtocol destructor. The search in progress is stopped.
+     */
+    ~EngineProtocol();
+
+    EngineProtocol(const EngineProtocol &) = delete;
+    EngineProtocol &operator=(const EngineProtocol &) = delete;
+
+    /*!
+     * \brief Execute a command
+     * \param command a command line, without its end of line
+     * \return `false` if the command was quit, `true` otherwise
+     */
+    bool execute(const std::string &command);
+
+    /*!
+     * \brief Check if a search is in progress
+     * \return `true` from a go command until its search ends
+     */
+    bool searching() const;
+
+    /*!
+     * \brief Return the search engine, to set its options between searches;
+     * depth and budget are set by each go command
+     * \return the search engine
+     */
+    Negamax &search();
+};
+
+#endif // ENGINEPROTOCOL_H
@@ -0,0 +1,220 @@
+/*! \file FixedBoard.h
+ * FixedBoard class definition
+ */
+
+#ifndef FIXEDBOARD_H
+#define FIXEDBOARD_H
+
+#include <array>
+#include <cstdint>
+
+/*!
+ * \brief Bits of a FixedBoard, computed at compile time.
+ * Cells are stored as in BitBoard: column by column, from the bottom of the
+ * column, each column being followed by a sentinel bit.
+ */
+template<unsigned Lines, unsigned Columns>
+struct FixedMasks
+{
+    /*!
+     * \brief Number of bits of a column, sentinel included
+     */
+    static constexpr unsigned HEIGHT = Lines + 1;
+
+    /*!
+     * \brief Return the bottom cell of the given column
+     * \param index the column
+     * \return the bottom cell of the column
+     */
+    static constexpr std::uint64_t bottom(unsigned index)
+    {
+        return std::uint64_t(1) << (index * HEIGHT);
+    }
+
+    /*!
+     * \brief Return the cells of the given column
+     * \param index the column
+     * \return the cells of the column
+     */
+    static constexpr std::uint64_t column(unsigned index)
+    {
+        return ((std::uint64_t(1) << Lines) - 1) << (index * HEIGHT);
+    }
+};
+
+/*!
+ * \brief Alignments of a plane, unrolled at compile time
+ */
+template<unsigned Power>
+struct FixedRuns
+{
+    /*!
+     * \brief Return the starts of the runs of Power bits spaced by shift
+     * \param bits the plane
+     * \param shift the distance between two cells of a run
+     * \return the first bit of each run
+     */
+    static std::uint64_t of(std::uint64_t bits, unsigned shift)
+    {
+        return bits & FixedRuns<Power - 1>::of(bits >> shift, shift);
+    }
+};
+
+/*!
+ * \brief End of the unrolling: a single bit is a run
+ */
+template<>
+struct FixedRuns<1>
+{
+    /*!
+     * \brief Return the plane
+     * \param bits the plane
+     * \return the plane
+     */
+    static std::uint64_t of(std::uint64_t bits, unsigned)
+    {
+        return bits;
+    }
+};
+
+/*!
+ * \brief A board whose size and power are known at compile time.
+ * The board holds a 64-bit plane per player and one of all the pieces, so
+ * that dropping a piece is an addition and looking for an alignment is a
+ * fixed sequence of shifts and ANDs over the whole plane, with no loop on
+ * the size of the board. It is meant for walks of the game tree that play
+ * and take back millions of moves, next to the runtime-sized ConnectN;
+ * boards are dispatched to it by dispatchBoard().
+ *
+ * Player 0 is the player who moves first.
+ */
+template<unsigned Power, unsigned Lines, unsigned Columns>
+class FixedBoard
+{
+public:
+    static_assert(Power >= 3 && Power <= 10,
+                  "Power must be comprised between 3 and 10");
+    static_assert((Lines + 1) * Columns <= 64,
+                  "A fixed board must fit in 64 bits");
+
+    /*!
+     * \brief Masks of the board
+     */
+    typedef FixedMasks<Lines, Columns> Masks;
+
+private:
+    std::array<std::uint64_t, 2> _pieces;
+    std::uint64_t _mask;
+    unsigned _moves;
+    std::array<std::uint64_t, Lines * Columns> _history;
+
+public:
+    /*!
+     * \brief FixedBoard constructor. The board is empty.
+     */
+    FixedBoard() :
+        _pieces(),
+        _mask(0),
+        _moves(0),
+        _history()
+    { }
+
+    /*!
+     * \brief Return the number of pieces to align
+     * \return the number of pieces to align
+     */
+    static constexpr unsigned power()
+    {
+        return Power;
+    }
+
+    /*!
+     * \brief Return the number of lines
+     * \return the number of lines
+     */
+    static constexpr unsigned line()
+    {
+        return Lines;
+    }
+
+    /*!
+     * \brief Return the number of columns
+     * \return the number of columns
+     */
+    static constexpr unsigned column()
+    {
+        return Columns;
+    }
+
+    /*!
+     * \brief Return the number of pieces on the board
+     * \return the number of pieces on the board
+     */
+    unsigned movesPlayed() const
+    {
+        return _moves;
+    }
+
+    /*!
+     * \brief Check if the board is full
+     * \return `true` if no piece can be dropped anymore
+     */
+    bool full() const
+    {
+        return _moves == Lines * Columns;
+    }
+
+    /*!
+     * \brief Check if a piece can be dropped in the given column
+     * \param column the column, less than Columns
+     * \return `true` if the column is not full
+     */
+    bool playable(unsigned column) const
+    {
+        return (_mask & Masks::column(column)) != Masks::column(column);
+    }
+
+    /*!
+     * \brief Drop a piece of the player to move in the given column.
+     * The column must be playable.
+     * \param column the column
+     * \return `true` if the player has an alignment, `false` otherwise
+     */
+    bool play(unsigned column)
+    {
+        std::uint64_t move = (_mask + Masks::bottom(column)) & Masks::column(column);
+        std::uint64_t &pieces = _pieces[_moves % 2];
+
+        _history[_moves++] = move;
+        _mask |= move;
+        pieces |= move;
+
+        return (FixedRuns<Power>::of(pieces, 1)
+                | FixedRuns<Power>::of(pieces, Masks::HEIGHT)
+                | FixedRuns<Power>::of(pieces, Masks::HEIGHT - 1)
+                | FixedRuns<Power>::of(pieces, Masks::HEIGHT + 1)) != 0;
+    }
+
+    /*!
+     * \brief Take back the last piece dropped.
+     * At least one piece must have been dropped.
+     */
+    void undo()
+    {
+        std::uint64_t move = _history[--_moves];
+        _mask ^= move;
+        _pieces[_moves % 2] ^= move;
+    }
+
+    /*!
+     * \brief Return the pieces of a player
+     * \param player 0 for the player who moved first, 1 for the other one
+     * \return the bits of the cells holding a piece of the player
+     */
+    std::uint64_t pieces(unsigned player) const
+    {
+        return _pieces[player];
+    }
+};
+
+#endif // FIXEDBOARD_H
@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "GameRecord.h"
+#include "BitBoard.h"
+#include "ConnectN.h"
+
+static_assert(BitBoard::MAX_COLUMN <= 1u << GameRecord::MOVE_BITS,
+              "A column must fit in the bits of a move");
+static_assert(BitBoard::MAX_LINE * BitBoard::MAX_COLUMN <= 0xffff,
+              "The number of moves must fit in 16 bits");
+
+/* Result of a game, relative to the enrollment order of its players */
+static GameRecord::Result result(const ConnectN &game)
+{
+    if (!game.finished()) {
+        return GameRecord::Result::UNFINISHED;
+    }
+    if (game.winner() == nullptr) {
+        return GameRecord::Result::DRAW;
+    }
+    return game.winner() == game.players()[0].first
+            ? GameRecord::Result::FIRST : GameRecord::Result::SECOND;
+}
+
+GameRecord GameRecord::of(const ConnectN &game)
+{
+    GameRecord record;
+    of(game, record);
+    return record;
+}
+
+void GameRecord::of(const ConnectN &game, GameRecord &record)
+{
+    if (!game.started()) {
+        throw std::logic_error("Game not yet started");
+    }
+
+    const auto players = game.players();
+    record.power = game.power();
+    record.line = game.line();
+    record.column = game.column();
+    record.color = players[0].second;
+    /* the first player moves again after an even number of moves */
+    bool firstActive = game.activePlayer() == players[0].first;
+    record.active = firstActive == (game.movesPlayed() % 2 == 0) ? 0 : 1;
+    record.result = ::result(game);
+    record.moves.resize(game.movesPlayed());
+    for (unsigned i = 0; i < game.movesPlayed(); i++) {
+        record.moves[i] = game.move(i);
+    }
+}
+
+void GameRecord::replay(ConnectN &game, const Player *first,
+                        const Player *second) const
+{
+    if (game.power() != power || game.line() != line
+            || game.column() != column) {
+        throw std::invalid_argument("Game size differs from the record");
+    }
+    game.enroll(first, second, color, active);
+    for (unsigned char move : moves) {
+        if (game.tryPlay(move) != ConnectN::MoveStatus::PLAYED) {
+            throw std::invalid_argument("Illegal move in the record");
+        }
+    }
+    if (::result(game) != result) {
+        throw std::invalid_argument("Result differs from the record");
+    }
+}
+
+std::size_t GameRecord::size() const
+{
+    return HEADER + (MOVE_BITS * moves.size() + 7) / 8;
+}
+
+void GameRecord::encode(unsigned char *out) const
+{
+    out[0] = power;
+    out[1] = line;
+    out[2] = column;
+    out[3] = (color == Color::WHITE ? 1 : 0) | active << 1
+            | static_cast<unsigned>(result) << 2;
+    out[4] = moves.size() & 0xff;
+    out[5] = moves.size() >> 8;
+
+    /* the moves are shifted in from the top of a bit buffer */
+    unsigned char *packed = out + HEADER;
+    std::uint32_t bits = 0;
+    unsigned count = 0;
+    for (unsigned char move : moves) {
+        bits |= std::uint32_t(move) << count;
+        count += MOVE_BITS;
+        if (count >= 8) {
+            *packed++ = bits & 0xff;
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+    if (count > 0) {
+        *packed = bits;
+    }
+}
+
+std::size_t GameRecord::decode(const unsigned char *in, std::size_t available,
+                               GameRecord &record)
+{
+    if (available < HEADER) {
+        return 0;
+    }
+    std::size_t moves = in[4] | in[5] << 8;
+    std::size_t size = HEADER + (MOVE_BITS * moves + 7) / 8;
+    if (available < size) {
+        return 0;
+    }
+
+    record.power = in[0];
+    record.line = in[1];
+    record.column = in[2];
+    record.color = in[3] & 1 ? Color::WHITE : Color::BLACK;
+    record.active = in[3] >> 1 & 1;
+    record.result = static_cast<Result>(in[3] >> 2 & 3);
+    record.moves.resize(moves);
+
+    const unsigned char *packed = in + HEADER;
+    std::uint32_t bits = 0;
+    unsigned count = 0;
+    for (std::size_t i = 0; i < moves; i++) {
+        if (count < MOVE_BITS) {
+            bits |= std::uint32_t(*packed++) << count;
+            count += 8;
+        }
+        record.moves[i] = bits & ((1u << MOVE_BITS) - 1);
+        bits >>= MOVE_BITS;
+        count -= MOVE_BITS;
+    }
+    return size;
+}
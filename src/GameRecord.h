@@ -0,0 +1,118 @@
+/*! \file GameRecord.h
+ * GameRecord struct definition
+ */
+
+#ifndef GAMERECORD_H
+#define GAMERECORD_H
+
+#include <cstddef>
+#include <vector>
+
+#include "Color.h"
+
+class ConnectN;
+class Player;
+
+/*!
+ * \brief A played game, in a compact binary form.
+ * A record is made of a 6-byte header followed by the columns played,
+ * packed at 5 bits per move from the low bits of the first byte:
+ *
+ *     offset  size  content
+ *          0     1  power
+ *          1     1  number of lines
+ *          2     1  number of columns
+ *          3     1  bit 0: color of players()[0], 0 for BLACK, 1 for WHITE
+ *                   bit 1: index in players() of the player who moved first
+ *                   bits 2-3: result, see Result
+ *          4     2  number of moves, low byte first
+ *          6     *  moves, (5 * moves + 7) / 8 bytes
+ *
+ * A game of 30 moves thus takes 25 bytes. Records are written by
+ * RecordWriter and read back by RecordReader.
+ */
+struct GameRecord
+{
+    /*!
+     * \brief The result of a recorded game
+     */
+    enum class Result : unsigned char {
+        UNFINISHED, /*!< the game was not finished */
+        DRAW, /*!< the board was filled without an alignment */
+        FIRST, /*!< players()[0] won */
+        SECOND /*!< players()[1] won */
+    };
+
+    /*!
+     * \brief Size of the header of a record, in bytes
+     */
+    static const std::size_t HEADER = 6;
+
+    /*!
+     * \brief Number of bits of a move
+     */
+    static const unsigned MOVE_BITS = 5;
+
+    unsigned power; /*!< number of pieces to align */
+    unsigned line; /*!< number of lines of the board */
+    unsigned column; /*!< number of columns of the board */
+    Color color; /*!< color of players()[0] */
+    unsigned active; /*!< index in players() of the player who moved first */
+    Result result; /*!< result of the game */
+    std::vector<unsigned char> moves; /*!< columns played */
+
+    /*!
+     * \brief Record a game
+     * \param game a started game
+     * \return the record of the game
+     * \throw std::logic_error if the game is not started
+     */
+    static GameRecord of(const ConnectN &game);
+
+    /*!
+     * \brief Record a game into an existing record
+     * \param game a started game
+     * \param record filled with the record of the game; its move vector is
+     * reused
+     * \throw std::logic_error if the game is not started
+     */
+    static void of(const ConnectN &game, GameRecord &record);
+
+    /*!
+     * \brief Replay the game on a game of the recorded size
+     * \param game a new game of the recorded size; the given players are
+     * enrolled with the recorded colors, and the moves are played
+     * \param first the player to enroll as players()[0]
+     * \param second the player to enroll as players()[1]
+     * \throw std::invalid_argument if the moves are illegal or do not lead
+     * to the recorded result
+     */
+    void replay(ConnectN &game, const Player *first,
+                const Player *second) const;
+
+    /*!
+     * \brief Return the size of the encoded record
+     * \return the number of bytes of the record
+     */
+    std::size_t size() const;
+
+    /*!
+     * \brief Encode the record
+     * \param out a buffer of at least size() bytes
+     */
+    void encode(unsigned char *out) const;
+
+    /*!
+     * \brief Decode a record
+     * \param in the encoded record
+     * \param available the number of bytes available from in
+     * \param record filled with the decoded record; its move vector is
+     * reused
+     * \return the size of the record, 0 if more than the available bytes
+     * are needed
+     */
+    static std::size_t decode(const unsigned char *in, std::size_t available,
+                              GameRecord &record);
+};
+
+#endif // GAMERECORD_H
@@ -0,0 +1,377 @@
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "GameServer.h"
+#include "ConnectN.h"
+#include "Negamax.h"
+#include "libs/stringConvert.hpp"
+
+/* A client socket; the descriptor is closed with the last reference, once
+ * the commands in flight are done */
+struct GameServer::Connection
+{
+    int fd;
+    std::mutex mutex; /* held while writing */
+    std::string input; /* bytes read after the last complete line */
+    bool open; /* under _sessionsMutex */
+    std::unordered_set<std::uint64_t> sessions; /* under _sessionsMutex */
+
+    explicit Connection(int fd) :
+        fd(fd),
+        mutex(),
+        input(),
+        open(true),
+        sessions()
+    { }
+
+    ~Connection()
+    {
+        close(fd);
+    }
+};
+
+/* A game and whether the computer is searching its move */
+struct GameServer::Session
+{
+    std::mutex mutex;
+    ConnectN game;
+    bool thinking;
+
+    explicit Session(const ConnectN &game) :
+        mutex(),
+        game(game),
+        thinking(false)
+    { }
+};
+
+/* Read the number following a command or a keyword */
+static std::uint64_t number(std::istream &in, const std::string &keyword)
+{
+    std::string word;
+    if (!(in >> word)) {
+        throw std::invalid_argument("Missing number after " + keyword);
+    }
+    return nvs::fromString<std::uint64_t>(word);
+}
+
+/* The suffix of a move ending a game */
+static std::string outcome(const ConnectN &game)
+{
+    if (!game.finished()) {
+        return "";
+    }
+    return game.winner() != nullptr ? " win" : " draw";
+}
+
+GameServer::GameServer(const std::string &path, unsigned workers,
+                       unsigned compute, unsigned depth) :
+    _path(path),
+    _listener(-1),
+    _wakeup{-1, -1},
+    _depth(depth),
+    _first("first"),
+    _second("second"),
+    _sessionsMutex(),
+    _sessions(),
+    _nextId(1),
+    _moves(0),
+    _compute(compute),
+    _workers(workers)
+{
+    if (depth == 0) {
+        throw std::out_of_range("Depth must be at least 1");
+    }
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size());
+
+    _listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (_listener < 0) {
+        throw std::runtime_error(std::string("Cannot create a socket: ")
+                                 + std::strerror(errno));
+    }
+    unlink(path.c_str());
+    if (bind(_listener, reinterpret_cast<sockaddr *>(&address),
+             sizeof(address)) < 0
+            || listen(_listener, SOMAXCONN) < 0
+            || fcntl(_listener, F_SETFL, O_NONBLOCK) < 0
+            || pipe(_wakeup) < 0) {
+        int error = errno;
+        close(_listener);
+        throw std::runtime_error("Cannot listen on " + path + ": "
+                                 + std::strerror(error));
+    }
+    fcntl(_wakeup[1], F_SETFL, O_NONBLOCK);
+}
+
+GameServer::~GameServer()
+{
+    close(_listener);
+    close(_wakeup[0]);
+    close(_wakeup[1]);
+    unlink(_path.c_str());
+}
+
+void GameServer::run()
+{
+    std::unordered_map<int, std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> fds;
+    char buffer[4096];
+
+    while (true) {
+        fds.clear();
+        fds.push_back({_wakeup[0], POLLIN, 0});
+        fds.push_back({_listener, POLLIN, 0});
+        for (const auto &connection : connections) {
+            fds.push_back({connection.first, POLLIN, 0});
+        }
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error(std::string("Cannot wait for clients: ")
+                                     + std::strerror(errno));
+        }
+        if (fds[0].revents != 0) {
+            break;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            int fd;
+            while ((fd = accept(_listener, nullptr, nullptr)) >= 0) {
+                fcntl(fd, F_SETFL, O_NONBLOCK);
+                connections[fd] = std::make_shared<Connection>(fd);
+            }
+        }
+
+        for (std::size_t i = 2; i < fds.size(); i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            std::shared_ptr<Connection> connection = connections[fds[i].fd];
+            ssize_t bytes;
+            while ((bytes = read(connection->fd, buffer, sizeof(buffer))) > 0) {
+                connection->input.append(buffer, bytes);
+            }
+            bool closed = bytes == 0 || (errno != EAGAIN
+                                         && errno != EWOULDBLOCK
+                                         && errno != EINTR);
+
+            /* each complete line is a command for the workers */
+            std::string &input = connection->input;
+            std::size_t start = 0;
+            std::size_t end;
+            while ((end = input.find('\n', start)) != std::string::npos) {
+                std::string command = input.substr(start, end - start);
+                _workers.submit([this, connection, command]() {
+                    handle(connection, command);
+                });
+                start = end + 1;
+            }
+            input.erase(0, start);
+
+            if (closed) {
+                disconnect(connection);
+                connections.erase(fds[i].fd);
+            }
+        }
+    }
+
+    for (const auto &connection : connections) {
+        disconnect(connection.second);
+    }
+}
+
+void GameServer::stop()
+{
+    char byte = 0;
+    if (write(_wakeup[1], &byte, 1) < 0) {
+        /* the pipe is full: run() is already woken up */
+    }
+}
+
+void GameServer::handle(const std::shared_ptr<Connection> &connection,
+                        const std::string &command)
+{
+    std::istringstream in(command);
+    std::string name;
+    std::string tag;
+    if (!(in >> name)) {
+        return;
+    }
+
+    try {
+        if (name == "new") {
+            unsigned power = ConnectN::DEFAULT_POWER;
+            unsigned line = ConnectN::DEFAULT_LINE;
+            unsigned column = ConnectN::DEFAULT_COLUMN;
+            std::string word;
+            if (in >> word) {
+                power = nvs::fromString<unsigned>(word);
+                line = number(in, "power");
+                column = number(in, "lines");
+            }
+            ConnectN game(power, line, column, 0);
+            game.enroll(&_first, &_second, Color::BLACK, 0);
+            auto session = std::make_shared<Session>(game);
+            std::uint64_t id;
+            {
+                std::lock_guard<std::mutex> lock(_sessionsMutex);
+                if (!connection->open) {
+                    return;
+                }
+                id = _nextId++;
+                _sessions[id] = session;
+                connection->sessions.insert(id);
+            }
+            reply(connection, "new " + std::to_string(id));
+        } else if (name == "play" || name == "ai" || name == "close") {
+            std::uint64_t id = number(in, name);
+            tag = std::to_string(id) + " ";
+            std::shared_ptr<Session> session = find(connection, id);
+            if (session == nullptr) {
+                throw std::invalid_argument("Unknown session");
+            }
+            if (name == "close") {
+                {
+                    std::lock_guard<std::mutex> lock(_sessionsMutex);
+                    _sessions.erase(id);
+                    connection->sessions.erase(id);
+                }
+                reply(connection, "closed " + std::to_string(id));
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(session->mutex);
+            ConnectN &game = session->game;
+            if (session->thinking) {
+                throw std::logic_error("The computer is playing");
+            }
+            if (game.finished()) {
+                throw std::logic_error("Game is over");
+            }
+            if (name == "play") {
+                std::uint64_t column = number(in, "session");
+                if (column >= game.column() || game.tryPlay(column)
+                        != ConnectN::MoveStatus::PLAYED) {
+                    throw std::invalid_argument("Illegal move");
+                }
+                _moves++;
+                if (game.finished()) {
+                    reply(connection, "end " + std::to_string(id)
+                          + outcome(game));
+                    return;
+                }
+            }
+            session->thinking = true;
+            _compute.submit([this, connection, id, session]() {
+                computerMove(connection, id, session);
+            });
+        } else if (name == "stats") {
+            std::ostringstream stats;
+            stats << "stats sessions " << sessions() << " moves " << moves();
+            reply(connection, stats.str());
+        } else {
+            throw std::invalid_argument("Unknown command " + name);
+        }
+    } catch (const nvs::bad_string_convert &) {
+        reply(connection, "error " + tag + "Invalid number");
+    } catch (const std::exception &e) {
+        reply(connection, "error " + tag + e.what());
+    }
+}
+
+void GameServer::computerMove(const std::shared_ptr<Connection> &connection,
+                              std::uint64_t id,
+                              const std::shared_ptr<Session> &session)
+{
+    /* the session is not locked while searching, commands are refused */
+    std::unique_lock<std::mutex> lock(session->mutex);
+    ConnectN game = session->game;
+    lock.unlock();
+
+    Negamax search(_depth);
+    unsigned column = search.bestMove(game);
+
+    lock.lock();
+    session->game.tryPlay(column);
+    session->thinking = false;
+    _moves++;
+    std::string line = "move " + std::to_string(id) + " "
+            + std::to_string(column) + outcome(session->game);
+    lock.unlock();
+    reply(connection, line);
+}
+
+std::shared_ptr<GameServer::Session> GameServer::find(
+        const std::shared_ptr<Connection> &connection, std::uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(_sessionsMutex);
+    if (connection->sessions.count(id) == 0) {
+        return nullptr;
+    }
+    return _sessions[id];
+}
+
+void GameServer::reply(const std::shared_ptr<Connection> &connection,
+                       const std::string &line)
+{
+    std::string data = line + '\n';
+    const char *bytes = data.data();
+    std::size_t left = data.size();
+
+    std::lock_guard<std::mutex> lock(connection->mutex);
+    while (left > 0) {
+        ssize_t sent = send(connection->fd, bytes, left, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            /* a client not reading for a second loses the line */
+            pollfd out = {connection->fd, POLLOUT, 0};
+            if ((errno == EAGAIN || errno == EWOULDBLOCK)
+                    && poll(&out, 1, 1000) > 0) {
+                continue;
+            }
+            return;
+        }
+        bytes += sent;
+        left -= sent;
+    }
+}
+
+void GameServer::disconnect(const std::shared_ptr<Connection> &connection)
+{
+    std::lock_guard<std::mutex> lock(_sessionsMutex);
+    connection->open = false;
+    for (std::uint64_t id : connection->sessions) {
+        _sessions.erase(id);
+    }
+    connection->sessions.clear();
+}
+
+std::size_t GameServer::sessions()
+{
+    std::lock_guard<std::mutex> lock(_sessionsMutex);
+    return _sessions.size();
+}
+
+std::uint64_t GameServer::moves() const
+{
+    return _moves;
+}
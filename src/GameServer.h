@@ -0,0 +1,141 @@
+/*! \file GameServer.h
+ * GameServer class definition
+ */
+
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Player.h"
+#include "ThreadPool.h"
+
+/*!
+ * \brief A server holding many games against the computer in one process.
+ * Clients connect to a local Unix socket and send commands, one per line;
+ * a connection can hold any number of sessions, each a game known by its
+ * id:
+ *
+ *     new [P L C]          start a game on the default board or the given
+ *                          one; answers `new ID`
+ *     play ID C            play column C for the player to move, then let
+ *                          the computer answer; answers `move ID C2`, with
+ *                          ` win` or ` draw` appended when the computer's
+ *                          move ends the game, or `end ID win` or
+ *                          `end ID draw` when C ends it
+ *     ai ID                let the computer play for the player to move;
+ *                          answers `move ID C` as above
+ *     close ID             end a session; answers `closed ID`
+ *     stats                answers `stats sessions N moves M`
+ *
+ * Invalid commands are answered by `error`, the session id when known, and
+ * the reason. Commands of one session must wait for the answer of the
+ * previous one; sessions are independent.
+ *
+ * A single thread waits for the sockets with poll() and only reads them:
+ * each line read is queued to a pool of workers, which apply the commands
+ * to the sessions. The moves of the computer, the costly part, are
+ * searched on a separate compute pool, so that a burst of searches does
+ * not delay the moves of the clients. Sessions end with their connection.
+ */
+class GameServer
+{
+public:
+    /*!
+     * \brief Default search depth of the computer
+     */
+    static const unsigned DEFAULT_DEPTH = 4;
+
+private:
+    struct Connection;
+    struct Session;
+
+    std::string _path;
+    int _listener;
+    int _wakeup[2];
+    unsigned _depth;
+    Player _first;
+    Player _second;
+    std::mutex _sessionsMutex;
+    std::unordered_map<std::uint64_t, std::shared_ptr<Session>> _sessions;
+    std::uint64_t _nextId;
+    std::atomic<std::uint64_t> _moves;
+    ThreadPool _compute;
+    ThreadPool _workers;
+
+    /* Apply a command line of a connection */
+    void handle(const std::shared_ptr<Connection> &connection,
+                const std::string &command);
+
+    /* Search and play the move of the computer in a session */
+    void computerMove(const std::shared_ptr<Connection> &connection,
+                      std::uint64_t id,
+                      const std::shared_ptr<Session> &session);
+
+    /* Find a session of a connection, nullptr if none */
+    std::shared_ptr<Session> find(const std::shared_ptr<Connection> &connection,
+                                  std::uint64_t id);
+
+    /* Send a line to a connection */
+    void reply(const std::shared_ptr<Connection> &connection,
+               const std::string &line);
+
+    /* Drop the sessions of a closed connection */
+    void disconnect(const std::shared_ptr<Connection> &connection);
+
+public:
+    /*!
+     * \brief GameServer constructor. Listen on a Unix socket; an existing
+     * file at the path is replaced.
+     * \param path the path of the socket
+     * \param workers number of threads applying the commands
+     * \param compute number of threads searching the moves of the computer
+     * \param depth search depth of the computer
+     * \throw std::out_of_range if workers, compute or depth is 0
+     * \throw std::runtime_error if the socket cannot be created
+     */
+    GameServer(const std::string &path, unsigned workers, unsigned compute,
+               unsigned depth = DEFAULT_DEPTH);
+
+    /*!
+     * \brief GameServer destructor. Pending commands are completed, then
+     * the socket is removed.
+     */
+    ~GameServer();
+
+    GameServer(const GameServer &) = delete;
+    GameServer &operator=(const GameServer &) = delete;
+
+    /*!
+     * \brief Serve the clients until stop() is called
+     * \throw std::runtime_error if waiting for the sockets fails
+     */
+    void run();
+
+    /*!
+     * \brief Make run() return. The call is safe from another thread and
+     * from a signal handler.
+     */
+    void stop();
+
+    /*!
+     * \brief Return the number of sessions
+     * \return the number of sessions in progress
+     */
+    std::size_t sessions();
+
+    /*!
+     * \brief Return the number of moves played
+     * \return the number of moves played in all the sessions, the moves of
+     * the computer included
+     */
+    std::uint64_t moves() const;
+};
+
+#endif // GAMESERVER_H
@@ -0,0 +1,143 @@
+/*! \file GenericBoard.h
+ * GenericBoard class definition
+ */
+
+#ifndef GENERICBOARD_H
+#define GENERICBOARD_H
+
+#include <array>
+
+#include "BitBoard.h"
+
+/*!
+ * \brief A board whose size and power are known at run time.
+ * It has the interface of FixedBoard, on top of a BitBoard, for the boards
+ * dispatchBoard() has no FixedBoard for.
+ *
+ * Player 0 is the player who moves first.
+ */
+class GenericBoard
+{
+private:
+    unsigned _power;
+    BitBoard _board;
+    unsigned _moves;
+    std::array<unsigned char, BitBoard::MAX_LINE * BitBoard::MAX_COLUMN> _history;
+
+public:
+    /*!
+     * \brief GenericBoard constructor. The board is empty.
+     * \param power number of pieces to align
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     * \throw std::out_of_range if the board exceeds BitBoard::MAX_LINE or
+     * BitBoard::MAX_COLUMN
+     */
+    GenericBoard(unsigned power, unsigned line, unsigned column);
+
+    /*!
+     * \brief Return the number of pieces to align
+     * \return the number of pieces to align
+     */
+    unsigned power() const;
+
+    /*!
+     * \brief Return the number of lines
+     * \return the number of lines
+     */
+    unsigned line() const;
+
+    /*!
+     * \brief Return the number of columns
+     * \return the number of columns
+     */
+    unsigned column() const;
+
+    /*!
+     * \brief Return the number of pieces on the board
+     * \return the number of pieces on the board
+     */
+    unsigned movesPlayed() const;
+
+    /*!
+     * \brief Check if the board is full
+     * \return `true` if no piece can be dropped anymore
+     */
+    bool full() const;
+
+    /*!
+     * \brief Check if a piece can be dropped in the given column
+     * \param column the column, less than column()
+     * \return `true` if the column is not full
+     */
+    bool playable(unsigned column) const;
+
+    /*!
+     * \brief Drop a piece of the player to move in the given column.
+     * The column must be playable.
+     * \param column the column
+     * \return `true` if the piece completes an alignment, `false` otherwise
+     */
+    bool play(unsigned column);
+
+    /*!
+     * \brief Take back the last piece dropped.
+     * At least one piece must have been dropped.
+     */
+    void undo();
+};
+
+/* Moves are on the hot path of tree walks: keep them inline */
+
+inline GenericBoard::GenericBoard(unsigned power, unsigned line,
+                                  unsigned column) :
+    _power(power),
+    _board(line, column),
+    _moves(0),
+    _history()
+{ }
+
+inline unsigned GenericBoard::power() const
+{
+    return _power;
+}
+
+inline unsigned GenericBoard::line() const
+{
+    return _board.line();
+}
+
+inline unsigned GenericBoard::column() const
+{
+    return _board.column();
+}
+
+inline unsigned GenericBoard::movesPlayed() const
+{
+    return _moves;
+}
+
+inline bool GenericBoard::full() const
+{
+    return _moves == _board.line() * _board.column();
+}
+
+inline bool GenericBoard::playable(unsigned column) const
+{
+    return _board.playable(column);
+}
+
+inline bool GenericBoard::play(unsigned column)
+{
+    Color color = _moves % 2 ? Color::WHITE : Color::BLACK;
+    unsigned line = _board.drop(column, color);
+    _history[_moves++] = column;
+    return _board.aligned(line, column, color, _power);
+}
+
+inline void GenericBoard::undo()
+{
+    _board.remove(_history[--_moves]);
+}
+
+#endif // GENERICBOARD_H
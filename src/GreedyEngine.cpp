@@ -0,0 +1,46 @@
+#include <array>
+
+#include "GreedyEngine.h"
+#include "ConnectN.h"
+
+GreedyEngine::GreedyEngine(std::uint64_t seed) :
+    _random(seed)
+{ }
+
+unsigned GreedyEngine::bestMove(const ConnectN &game)
+{
+    Color own = game.color(game.activePlayer());
+    Color other = own == Color::BLACK ? Color::WHITE : Color::BLACK;
+    std::array<unsigned, BitBoard::MAX_COLUMN> safe;
+    std::array<unsigned, BitBoard::MAX_COLUMN> unsafe;
+    unsigned safeCount = 0;
+    unsigned unsafeCount = 0;
+
+    for (unsigned column = 0; column < game.column(); column++) {
+        if (game.winningMove(column, own)) {
+            return column;
+        }
+    }
+    for (unsigned column = 0; column < game.column(); column++) {
+        if (game.winningMove(column, other)) {
+            return column;
+        }
+    }
+
+    for (unsigned column = 0; column < game.column(); column++) {
+        ConnectN next = game;
+        if (next.tryPlay(column) != ConnectN::MoveStatus::PLAYED) {
+            continue;
+        }
+        if (!next.finished() && next.winningMove(column, other)) {
+            unsafe[unsafeCount++] = column;
+        } else {
+            safe[safeCount++] = column;
+        }
+    }
+
+    if (safeCount > 0) {
+        return safe[_random.below(safeCount)];
+    }
+    return unsafe[_random.below(unsafeCount)];
+}
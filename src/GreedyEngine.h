@@ -0,0 +1,40 @@
+/*! \file GreedyEngine.h
+ * GreedyEngine class definition
+ */
+
+#ifndef GREEDYENGINE_H
+#define GREEDYENGINE_H
+
+#include <cstdint>
+
+#include "Engine.h"
+#include "Random.h"
+
+/*!
+ * \brief An engine looking one move ahead.
+ * It wins at once when it can, otherwise blocks the column where the other
+ * player would win. Other moves are chosen at random, avoiding the columns
+ * where the other player could win right above the piece played.
+ */
+class GreedyEngine : public Engine
+{
+private:
+    Random _random;
+
+public:
+    /*!
+     * \brief GreedyEngine constructor
+     * \param seed the seed of the random moves
+     */
+    GreedyEngine(std::uint64_t seed);
+
+    /*!
+     * \brief Choose the column where the active player should play.
+     * \param game a started, not finished game
+     * \return a winning column, a column blocking the other player, or a
+     * random column
+     */
+    unsigned bestMove(const ConnectN &game) override;
+};
+
+#endif // GREEDYENGINE_H
@@ -0,0 +1,262 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Mcts.h"
+#include "ConnectN.h"
+
+double MctsStats::playoutsPerSecond() const
+{
+    return seconds > 0 ? playouts / seconds : 0;
+}
+
+Mcts::Mcts(unsigned playouts, unsigned threads, std::uint64_t seed) :
+    _playouts(playouts),
+    _threads(threads),
+    _exploration(std::sqrt(2.0)),
+    _random(seed),
+    _nodes(nullptr),
+    _started(0),
+    _power(0),
+    _cells(0),
+    _colors{{Color::BLACK, Color::WHITE}},
+    _stats{0, 0, 0}
+{
+    if (playouts == 0) {
+        throw std::out_of_range("At least one playout is needed");
+    }
+    if (threads == 0) {
+        throw std::out_of_range("At least one thread is needed");
+    }
+}
+
+unsigned Mcts::bestMove(const ConnectN &game)
+{
+    auto start = std::chrono::steady_clock::now();
+    unsigned moves = game.movesPlayed();
+    std::vector<std::thread> helpers;
+
+    /* each expansion adds at most one node per column */
+    unsigned capacity = unsigned(std::min<std::uint64_t>(
+            MAX_NODES, std::uint64_t(_playouts) * game.column() + 1));
+    NodePool<Node> &nodes = NodePool<Node>::local();
+    nodes.reserve(capacity);
+    _nodes = &nodes;
+    _power = game.power();
+    _cells = game.line() * game.column();
+    /* the colors are dealt at random: either may move first */
+    Color active = game.color(game.activePlayer());
+    _colors[moves % 2] = active;
+    _colors[1 - moves % 2] = active == Color::BLACK ? Color::WHITE
+                                                    : Color::BLACK;
+    _started = 0;
+    unsigned root;
+    nodes.allocate(1, root);
+    reset(nodes[root], 0);
+
+    for (unsigned i = 1; i < _threads; i++) {
+        helpers.emplace_back(&Mcts::search, this, std::cref(game.bitBoard()),
+                             moves, _random());
+    }
+    search(game.bitBoard(), moves, _random());
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+
+    unsigned best = 0;
+    std::uint32_t visits = 0;
+    for (unsigned i = 0; i < nodes[root].children; i++) {
+        const Node &child = nodes[nodes[root].first + i];
+        if (i == 0 || child.visits > visits) {
+            best = child.move;
+            visits = child.visits;
+        }
+    }
+
+    _stats.playouts = _playouts;
+    _stats.nodes = nodes.size();
+    _nodes = nullptr;
+    _stats.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+
+    return best;
+}
+
+void Mcts::search(const BitBoard &board, unsigned moves, std::uint64_t seed)
+{
+    NodePool<Node> &nodes = *_nodes;
+    Random random(seed);
+    std::array<unsigned, BitBoard::MAX_LINE * BitBoard::MAX_COLUMN + 1> path;
+
+    while (_started++ < _playouts) {
+        BitBoard current = board;
+        unsigned played = moves;
+        unsigned node = 0;
+        unsigned length = 0;
+        unsigned winner = 3;
+
+        /* walk down the tree */
+        nodes[0].visits += VIRTUAL_LOSS;
+        path[length++] = 0;
+        while (winner == 3) {
+            Node &parent = nodes[node];
+            if (parent.state.load(std::memory_order_acquire) != EXPANDED
+                    && ((node != 0 && parent.visits <= VIRTUAL_LOSS)
+                        || !expand(node, current))) {
+                /* first visit of a leaf, or no room for its children */
+                winner = rollout(current, played, random);
+                break;
+            }
+
+            double logVisits = std::log(double(parent.visits) + 1);
+            double bestScore = -1;
+            for (unsigned i = 0; i < parent.children; i++) {
+                const Node &child = nodes[parent.first + i];
+                std::uint32_t visits = child.visits;
+                if (visits == 0) {
+                    node = parent.first + i;
+                    break;
+                }
+                double score = child.reward / (2.0 * visits)
+                        + _exploration * std::sqrt(logVisits / visits);
+                if (score > bestScore) {
+                    bestScore = score;
+                    node = parent.first + i;
+                }
+            }
+
+            Node &child = nodes[node];
+            child.visits += VIRTUAL_LOSS;
+            path[length++] = node;
+            Color color = _colors[played % 2];
+            unsigned line = current.drop(child.move, color);
+            if (current.aligned(line, child.move, color, _power)) {
+                winner = played % 2;
+            } else if (played + 1 == _cells) {
+                winner = 2;
+            }
+            played++;
+        }
+
+        /* credit the result, removing the virtual losses */
+        for (unsigned i = 0; i < length; i++) {
+            Node &visited = nodes[path[i]];
+            visited.visits -= VIRTUAL_LOSS - 1;
+            /* the move leading to the node was played by parity
+             * moves + i - 1 */
+            if (winner == 2) {
+                visited.reward += 1;
+            } else if (i > 0 && winner == (moves + i - 1) % 2) {
+                visited.reward += 2;
+            }
+        }
+    }
+}
+
+bool Mcts::expand(unsigned node, const BitBoard &board)
+{
+    NodePool<Node> &nodes = *_nodes;
+    Node &parent = nodes[node];
+    std::uint8_t state = LEAF;
+
+    if (!parent.state.compare_exchange_strong(state, EXPANDING)) {
+        return state == EXPANDED;
+    }
+
+    unsigned count = 0;
+    for (unsigned column = 0; column < board.column(); column++) {
+        count += board.playable(column);
+    }
+    unsigned first;
+    if (!nodes.allocate(count, first)) {
+        /* the pool is exhausted: leave the node as a leaf for good */
+        parent.state.store(EXPANDING, std::memory_order_release);
+        return false;
+    }
+
+    unsigned child = first;
+    for (unsigned column = 0; column < board.column(); column++) {
+        if (board.playable(column)) {
+            reset(nodes[child++], column);
+        }
+    }
+    parent.first = first;
+    parent.children = count;
+    parent.state.store(EXPANDED, std::memory_order_release);
+
+    return true;
+}
+
+unsigned Mcts::rollout(BitBoard &board, unsigned moves, Random &random) const
+{
+    std::array<unsigned char, BitBoard::MAX_COLUMN> columns;
+    unsigned count = 0;
+
+    for (unsigned column = 0; column < board.column(); column++) {
+        if (board.playable(column)) {
+            columns[count++] = column;
+        }
+    }
+
+    while (moves < _cells) {
+        unsigned index = random.below(count);
+        unsigned column = columns[index];
+        Color color = _colors[moves % 2];
+        unsigned line = board.drop(column, color);
+        if (board.aligned(line, column, color, _power)) {
+            return moves % 2;
+        }
+        if (!board.playable(column)) {
+            columns[index] = columns[--count];
+        }
+        moves++;
+    }
+
+    return 2;
+}
+
+void Mcts::reset(Node &fresh, unsigned move)
+{
+    fresh.visits.store(0, std::memory_order_relaxed);
+    fresh.reward.store(0, std::memory_order_relaxed);
+    fresh.first = 0;
+    fresh.children = 0;
+    fresh.move = move;
+    fresh.state.store(LEAF, std::memory_order_relaxed);
+}
+
+unsigned Mcts::playouts() const
+{
+    return _playouts;
+}
+
+void Mcts::playouts(unsigned playouts)
+{
+    if (playouts == 0) {
+        throw std::out_of_range("At least one playout is needed");
+    }
+    _playouts = playouts;
+}
+
+unsigned Mcts::threads() const
+{
+    return _threads;
+}
+
+void Mcts::threads(unsigned threads)
+{
+    if (threads == 0) {
+        throw std::out_of_range("At least one thread is needed");
+    }
+    _threads = threads;
+}
+
+const MctsStats &Mcts::stats() const
+{
+    return _stats;
+}
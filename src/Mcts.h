@@ -0,0 +1,161 @@
+/*! \file Mcts.h
+ * Mcts class definition
+ */
+
+#ifndef MCTS_H
+#define MCTS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include "Engine.h"
+#include "BitBoard.h"
+#include "Color.h"
+#include "NodePool.h"
+#include "Random.h"
+
+/*!
+ * \brief Statistics of a Monte Carlo tree search
+ */
+struct MctsStats
+{
+    std::uint64_t playouts; /*!< number of games played to the end */
+    unsigned nodes; /*!< number of nodes of the tree */
+    double seconds; /*!< time spent searching */
+
+    /*!
+     * \brief Return the search speed
+     * \return the number of playouts per second
+     */
+    double playoutsPerSecond() const;
+};
+
+/*!
+ * \brief A Monte Carlo tree search engine (UCT).
+ * Each playout walks down the tree, choosing at each node the move with the
+ * best upper confidence bound, adds the children of the node reached if it
+ * was already visited, then plays random moves until the end of the game.
+ * The result is credited to every node of the walk. The most visited move of
+ * the root is played.
+ *
+ * Playouts only handle a BitBoard and the number of pieces, never a full
+ * ConnectN. With several threads, all of them grow the same tree; a thread
+ * walking through a node adds a virtual loss to it until its playout is
+ * credited, so that the other threads explore other moves meanwhile. The
+ * nodes are taken from the NodePool of the thread calling bestMove(), kept
+ * from move to move and from game to game, and shared by the engines of
+ * that thread; once it is exhausted, the tree stops growing and playouts go
+ * on from its leaves.
+ */
+class Mcts : public Engine
+{
+public:
+    /*!
+     * \brief Default number of playouts per move
+     */
+    static const unsigned DEFAULT_PLAYOUTS = 100000;
+
+    /*!
+     * \brief Largest number of nodes of the tree
+     */
+    static const unsigned MAX_NODES = 1 << 22;
+
+    /*!
+     * \brief Number of lost playouts a thread walking through a node adds to
+     * it
+     */
+    static const unsigned VIRTUAL_LOSS = 3;
+
+private:
+    /* Expansion state of a node */
+    enum : std::uint8_t { LEAF, EXPANDING, EXPANDED };
+
+    /* A node of the tree; the reward is counted in half points for the
+     * player who played the move leading to the node */
+    struct Node
+    {
+        std::atomic<std::uint32_t> visits;
+        std::atomic<std::uint32_t> reward;
+        std::uint32_t first;
+        std::uint8_t children;
+        std::uint8_t move;
+        std::atomic<std::uint8_t> state;
+    };
+
+    unsigned _playouts;
+    unsigned _threads;
+    double _exploration;
+    Random _random;
+    NodePool<Node> *_nodes; /* during a search */
+    std::atomic<std::uint64_t> _started;
+    unsigned _power;
+    unsigned _cells;
+    std::array<Color, 2> _colors; /* color of the moves by parity */
+    MctsStats _stats;
+
+    /* Play playouts from the given board until the budget is spent */
+    void search(const BitBoard &board, unsigned moves, std::uint64_t seed);
+
+    /* Add the children of a node, false if another thread is adding them or
+     * the pool is exhausted */
+    bool expand(unsigned node, const BitBoard &board);
+
+    /* Play random moves until the end of the game; return the parity of the
+     * winning move, 2 for a draw */
+    unsigned rollout(BitBoard &board, unsigned moves, Random &random) const;
+
+    /* Initialize a node of the pool */
+    void reset(Node &node, unsigned move);
+
+public:
+    /*!
+     * \brief Mcts constructor
+     * \param playouts number of playouts per move
+     * \param threads number of search threads
+     * \param seed the seed of the random moves
+     * \throw std::out_of_range if playouts or threads is 0
+     */
+    Mcts(unsigned playouts = DEFAULT_PLAYOUTS, unsigned threads = 1,
+         std::uint64_t seed = 0);
+
+    /*!
+     * \brief Choose the column where the active player should play.
+     * \param game a started, not finished game
+     * \return the column visited by the most playouts
+     */
+    unsigned bestMove(const ConnectN &game) override;
+
+    /*!
+     * \brief Return the number of playouts per move
+     * \return the number of playouts per move
+     */
+    unsigned playouts() const;
+
+    /*!
+     * \brief Set the number of playouts per move
+     * \param playouts the number of playouts per move
+     * \throw std::out_of_range if playouts is 0
+     */
+    void playouts(unsigned playouts);
+
+    /*!
+     * \brief Return the number of search threads
+     * \return the number of search threads
+     */
+    unsigned threads() const;
+
+    /*!
+     * \brief Set the number of search threads
+     * \param threads number of search threads
+     * \throw std::out_of_range if threads is 0
+     */
+    void threads(unsigned threads);
+
+    /*!
+     * \brief Return the statistics of the last search
+     * \return the statistics of the last search
+     */
+    const MctsStats &stats() const;
+};
+
+#endif // MCTS_H
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "MoveOrder.h"
+#include "Alignments.h"
+#include "ConnectN.h"
+
+MoveOrder::MoveOrder(unsigned power, unsigned line, unsigned column,
+                     Heuristic heuristic) :
+    _heuristic(heuristic),
+    _power(power),
+    _line(line),
+    _column(column),
+    _cells(Alignments::cells(line, column)),
+    _order()
+{
+    for (unsigned i = 0; i < column; i++) {
+        _order[i] = i;
+    }
+    if (heuristic != Heuristic::COLUMN) {
+        /* ties are broken by column: the same order as a stable sort,
+         * without its buffer from the global allocator */
+        std::sort(_order.begin(), _order.begin() + column,
+        [column](unsigned a, unsigned b) {
+            int distanceA = std::abs(2 * int(a) - int(column) + 1);
+            int distanceB = std::abs(2 * int(b) - int(column) + 1);
+            return distanceA < distanceB || (distanceA == distanceB && a < b);
+        });
+    }
+}
+
+MoveOrder::Heuristic MoveOrder::heuristic() const
+{
+    return _heuristic;
+}
+
+unsigned MoveOrder::hinted(const Moves &candidates, unsigned size,
+                           const std::array<unsigned, 2> &hints,
+                           Moves &moves) const
+{
+    unsigned count = 0;
+    for (unsigned i = 0; i < hints.size(); i++) {
+        if (i > 0 && hints[i] == hints[0]) {
+            continue;
+        }
+        if (std::find(candidates.begin(), candidates.begin() + size, hints[i])
+                != candidates.begin() + size) {
+            moves[count++] = hints[i];
+        }
+    }
+    for (unsigned i = 0; i < size; i++) {
+        if (candidates[i] != hints[0] && candidates[i] != hints[1]) {
+            moves[count++] = candidates[i];
+        }
+    }
+    return count;
+}
+
+unsigned MoveOrder::order(const ConnectN &game,
+                          const std::array<unsigned, 2> &hints, bool scored,
+                          Moves &moves) const
+{
+    const BitBoard &board = game.bitBoard();
+    Moves candidates;
+    unsigned size = 0;
+
+    if (_heuristic != Heuristic::THREATS) {
+        for (unsigned i = 0; i < _column; i++) {
+            if (board.playable(_order[i])) {
+                candidates[size++] = _order[i];
+            }
+        }
+        return hinted(candidates, size, hints, moves);
+    }
+
+    Color own = game.color(game.activePlayer());
+    Color other = own == Color::BLACK ? Color::WHITE : Color::BLACK;
+    BitPlane empty = _cells & ~(board.plane(Color::BLACK)
+                                | board.plane(Color::WHITE));
+    BitPlane wins = Alignments::threats(board.plane(own), empty, _line, _power);
+    BitPlane losses = Alignments::threats(board.plane(other), empty, _line,
+                                          _power);
+
+    /* the next cell of each playable column, in central order */
+    std::array<unsigned, BitBoard::MAX_COLUMN> cells;
+    Moves playable;
+    unsigned count = 0;
+    for (unsigned i = 0; i < _column; i++) {
+        unsigned column = _order[i];
+        if (board.playable(column)) {
+            playable[count] = column;
+            cells[count++] = board.bit(_line - 1 - board.height(column),
+                                       column);
+        }
+    }
+
+    /* a win at once needs no other move */
+    for (unsigned i = 0; i < count; i++) {
+        if (wins.test(cells[i])) {
+            moves[size++] = playable[i];
+        }
+    }
+    if (size > 0) {
+        return size;
+    }
+    /* any move but a block lets the opponent win at once */
+    for (unsigned i = 0; i < count; i++) {
+        if (losses.test(cells[i])) {
+            moves[size++] = playable[i];
+        }
+    }
+    if (size > 0) {
+        return size;
+    }
+
+    /* never play below a cell where the opponent would win, unless every
+     * move does; the cell above a move is the next bit of the plane */
+    for (unsigned i = 0; i < count; i++) {
+        if (board.height(playable[i]) + 1 == _line
+                || !losses.test(cells[i] + 1)) {
+            candidates[size++] = playable[i];
+        }
+    }
+    if (size == 0) {
+        size = count;
+        std::copy(playable.begin(), playable.begin() + size,
+                  candidates.begin());
+    }
+
+    if (scored) {
+        /* insertion sort on the threats left by each move, stable so that
+         * central columns stay first on ties */
+        std::array<unsigned, BitBoard::MAX_COLUMN> scores;
+        for (unsigned i = 0; i < size; i++) {
+            unsigned column = candidates[i];
+            unsigned bit = board.bit(_line - 1 - board.height(column), column);
+            BitPlane pieces = board.plane(own);
+            BitPlane left = empty;
+            pieces.set(bit);
+            left.reset(bit);
+            unsigned score = Alignments::threats(pieces, left, _line, _power)
+                    .count();
+            unsigned j = i;
+            while (j > 0 && scores[j - 1] < score) {
+                scores[j] = scores[j - 1];
+                candidates[j] = candidates[j - 1];
+                j--;
+            }
+            scores[j] = score;
+            candidates[j] = column;
+        }
+    }
+    return hinted(candidates, size, hints, moves);
+}
@@ -0,0 +1,94 @@
+/*! \file MoveOrder.h
+ * MoveOrder class definition
+ */
+
+#ifndef MOVEORDER_H
+#define MOVEORDER_H
+
+#include <array>
+
+#include "BitBoard.h"
+#include "BitPlane.h"
+
+class ConnectN;
+
+/*!
+ * \brief The order in which a search tries the moves of a position.
+ * An alpha-beta search cuts more branches when the best move comes first.
+ * Three heuristics are available:
+ *
+ * - COLUMN: the columns from left to right;
+ * - CENTER: central columns first, as they take part in more alignments;
+ * - THREATS: moves winning at once only; otherwise moves blocking a win of
+ *   the opponent only, as any other move loses at once; otherwise the moves
+ *   not letting the opponent win in the cell right above, by decreasing
+ *   number of threats they leave (empty cells where the player would
+ *   complete an alignment), central columns first on ties.
+ *
+ * The search can give up to two moves it expects to be good, from a
+ * previous iteration or from its transposition table; they are tried first
+ * unless the heuristic pruned them.
+ */
+class MoveOrder
+{
+public:
+    /*!
+     * \brief The ordering heuristic
+     */
+    enum class Heuristic {
+        COLUMN, /*!< left to right */
+        CENTER, /*!< central columns first */
+        THREATS /*!< wins, forced blocks, then threats, losing moves pruned */
+    };
+
+    /*!
+     * \brief A list of columns
+     */
+    typedef std::array<unsigned char, BitBoard::MAX_COLUMN> Moves;
+
+private:
+    Heuristic _heuristic;
+    unsigned _power;
+    unsigned _line;
+    unsigned _column;
+    BitPlane _cells;
+    Moves _order;
+
+    /* Put the hinted moves found in candidates first in moves, then the
+     * other candidates; return the number of moves */
+    unsigned hinted(const Moves &candidates, unsigned size,
+                    const std::array<unsigned, 2> &hints, Moves &moves) const;
+
+public:
+    /*!
+     * \brief MoveOrder constructor
+     * \param power number of pieces to align
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     * \param heuristic the ordering heuristic
+     */
+    MoveOrder(unsigned power, unsigned line, unsigned column,
+              Heuristic heuristic = Heuristic::THREATS);
+
+    /*!
+     * \brief Return the ordering heuristic
+     * \return the ordering heuristic
+     */
+    Heuristic heuristic() const;
+
+    /*!
+     * \brief Order the moves of a position
+     * \param game a started, not finished game of the size of the order
+     * \param hints moves to try first if they are kept; columns out of the
+     * board are ignored
+     * \param scored `false` to skip counting the threats of each move, which
+     * costs more than it saves close to the search horizon; the moves then
+     * keep the central order
+     * \param moves filled with the columns to try, best first
+     * \return the number of moves
+     */
+    unsigned order(const ConnectN &game, const std::array<unsigned, 2> &hints,
+                   bool scored, Moves &moves) const;
+};
+
+#endif // MOVEORDER_H
@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Negamax.h"
+#include "Arena.h"
+#include "ConnectN.h"
+
+double SearchStats::nodesPerSecond() const
+{
+    return seconds > 0 ? nodes / seconds : 0;
+}
+
+double SearchStats::hitRate() const
+{
+    return probes > 0 ? double(hits) / probes : 0;
+}
+
+Negamax::Negamax(unsigned depth, std::shared_ptr<TranspositionTable> table,
+                 unsigned threads) :
+    _depth(depth),
+    _budget(0),
+    _deadline(),
+    _threads(threads),
+    _table(table),
+    _book(nullptr),
+    _symmetry(false),
+    _columns(0),
+    _ordering(MoveOrder::Heuristic::THREATS),
+    _moveOrder(ConnectN::DEFAULT_POWER, ConnectN::DEFAULT_LINE,
+               ConnectN::DEFAULT_COLUMN),
+    _stop(false),
+    _halt(false),
+    _stats{0, 0, 0, 0, 0, {}, false}
+{
+    if (depth == 0) {
+        throw std::out_of_range("Depth must be at least 1");
+    }
+    if (threads == 0) {
+        throw std::out_of_range("At least one thread is needed");
+    }
+}
+
+unsigned Negamax::bestMove(const ConnectN &game)
+{
+    auto start = std::chrono::steady_clock::now();
+    unsigned move;
+    if (_book != nullptr && _book->probe(game, move)) {
+        resetStats();
+        _stats.book = true;
+        return move;
+    }
+
+    unsigned threads = _table != nullptr ? _threads : 1;
+    unsigned empty = game.line() * game.column() - game.movesPlayed();
+    Worker worker{game, game.movesPlayed(), game.column(), 0, 0, 0, false,
+                  false, 0, {}, {}, {}};
+    /* the workers are scratch memory of the calling thread */
+    Arena::Scope scope(Arena::local());
+    Worker *workers = Arena::local().make(threads, worker);
+    std::vector<std::thread> helpers;
+
+    _columns = game.column();
+    _moveOrder = MoveOrder(game.power(), game.line(), game.column(),
+                           _ordering);
+
+    resetStats();
+    _deadline = start + std::chrono::milliseconds(_budget);
+    _stop = false;
+
+    /* every other helper looks one move further */
+    for (unsigned i = 1; i < threads; i++) {
+        helpers.emplace_back([this, workers, i, empty]() {
+            iterate(workers[i], 1 + i % 2, empty);
+        });
+    }
+    workers[0].main = true;
+    iterate(workers[0], 1, std::min(_depth, empty));
+    _stop = true;
+    for (auto &helper : helpers) {
+        helper.join();
+    }
+
+    for (unsigned i = 0; i < threads; i++) {
+        _stats.nodes += workers[i].nodes;
+        _stats.probes += workers[i].probes;
+        _stats.hits += workers[i].hits;
+    }
+    _stats.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+
+    return workers[0].best;
+}
+
+void Negamax::resetStats()
+{
+    /* the iterations keep their memory from search to search */
+    _stats.nodes = 0;
+    _stats.probes = 0;
+    _stats.hits = 0;
+    _stats.seconds = 0;
+    _stats.depth = 0;
+    _stats.iterations.clear();
+    _stats.book = false;
+}
+
+void Negamax::iterate(Worker &worker, unsigned depth, unsigned maxDepth)
+{
+    for (; depth <= maxDepth && !_stop; depth++) {
+        auto start = std::chrono::steady_clock::now();
+        worker.followPv = true;
+        int score = negamax(worker, depth, -INT_MAX, INT_MAX);
+        if (_stop) {
+            break;
+        }
+        /* the root only sets its move when its search is complete */
+        worker.pvLength = worker.pvLengths[0];
+        worker.pv = worker.pvTable[0];
+        if (worker.main) {
+            _stats.depth = depth;
+            _stats.iterations.push_back(std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start).count());
+        }
+        /* a forced result does not change with depth */
+        if (std::abs(score) > WIN_SCORE - int(BitBoard::MAX_LINE
+                                              * BitBoard::MAX_COLUMN)) {
+            break;
+        }
+    }
+}
+
+int Negamax::negamax(Worker &worker, unsigned depth, int alpha, int beta)
+{
+    ConnectN &game = worker.game;
+    unsigned ply = game.movesPlayed() - worker.rootMoves;
+    bool root = ply == 0;
+    bool followPv = worker.followPv;
+    TranspositionTable::Entry entry;
+    bool mirrored = _symmetry && game.mirrored();
+    std::uint64_t key = mirrored ? game.mirrorHash() : game.hash();
+    std::array<unsigned, 2> first{{_columns, _columns}};
+    unsigned bestColumn = _columns;
+    int best = -INT_MAX;
+
+    worker.nodes++;
+    if (ply < MAX_PV) {
+        worker.pvLengths[ply] = 0;
+    }
+    if (_stop.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    /* only the main thread keeps time and stops, once it has a move to
+     * play */
+    if (worker.main && _stats.depth > 0 && worker.nodes % 1024 == 0
+            && (_halt.load(std::memory_order_relaxed)
+                || (_budget > 0
+                    && std::chrono::steady_clock::now() >= _deadline))) {
+        _stop = true;
+        return 0;
+    }
+    if (depth == 0) {
+        return evaluate(game);
+    }
+
+    /* the table is shared: its lookups are counted by each worker */
+    if (_table != nullptr) {
+        worker.probes++;
+    }
+    if (_table != nullptr && _table->probe(key, entry)) {
+        worker.hits++;
+        first[1] = mirrored && entry.move < _columns ? game.mirror(entry.move)
+                                                     : entry.move;
+        if (!root && entry.depth >= depth) {
+            if (entry.bound == TranspositionTable::Bound::EXACT) {
+                return entry.score;
+            } else if (entry.bound == TranspositionTable::Bound::LOWER) {
+                alpha = std::max(alpha, entry.score);
+            } else if (entry.bound == TranspositionTable::Bound::UPPER) {
+                beta = std::min(beta, entry.score);
+            }
+            if (alpha >= beta) {
+                return entry.score;
+            }
+        }
+    }
+    if (followPv && ply < worker.pvLength) {
+        first[0] = worker.pv[ply];
+    }
+
+    /* the principal variation of the previous iteration first, then the best
+     * move stored in the table, then the order of the heuristic */
+    int alphaOrigin = alpha;
+    MoveOrder::Moves moves;
+    unsigned size = _moveOrder.order(game, first, depth >= SCORED_DEPTH,
+                                     moves);
+    for (unsigned i = 0; i < size && alpha < beta; i++) {
+        unsigned column = moves[i];
+        int score;
+        game.tryPlay(column);
+        if (ply + 1 < MAX_PV) {
+            worker.pvLengths[ply + 1] = 0;
+        }
+        if (game.winner() != nullptr) {
+            /* the sooner the better */
+            score = WIN_SCORE - game.movesPlayed();
+        } else if (game.finished()) {
+            score = 0;
+        } else {
+            worker.followPv = followPv && column == first[0];
+            score = -negamax(worker, depth - 1, -beta, -alpha);
+        }
+        game.undo();
+        if (score > best) {
+            best = score;
+            bestColumn = column;
+            if (score > alpha) {
+                alpha = score;
+                if (ply < MAX_PV) {
+                    unsigned length = 0;
+                    if (ply + 1 < MAX_PV) {
+                        length = std::min(unsigned(worker.pvLengths[ply + 1]),
+                                          MAX_PV - 1);
+                    }
+                    worker.pvTable[ply][0] = column;
+                    std::copy(worker.pvTable[ply + 1].begin(),
+                              worker.pvTable[ply + 1].begin() + length,
+                              worker.pvTable[ply].begin() + 1);
+                    worker.pvLengths[ply] = length + 1;
+                }
+            }
+        }
+    }
+    worker.followPv = false;
+
+    if (_stop.load(std::memory_order_relaxed)) {
+        return 0;
+    }
+    if (_table != nullptr) {
+        TranspositionTable::Bound bound = TranspositionTable::Bound::EXACT;
+        if (best <= alphaOrigin) {
+            bound = TranspositionTable::Bound::UPPER;
+        } else if (best >= beta) {
+            bound = TranspositionTable::Bound::LOWER;
+        }
+        unsigned move = mirrored && bestColumn < _columns
+                ? game.mirror(bestColumn) : bestColumn;
+        _table->store(key, {best, depth, bound, move});
+    }
+    if (root) {
+        worker.best = bestColumn;
+    }
+
+    return best;
+}
+
+int Negamax::evaluate(const ConnectN &game) const
+{
+    const BitBoard &board = game.bitBoard();
+    Color active = game.color(game.activePlayer());
+    int score = 0;
+
+    for (unsigned column = 0; column < _columns; column++) {
+        int weight = _columns - std::abs(2 * int(column) - int(_columns) + 1);
+        for (unsigned line = board.line() - board.height(column);
+             line < board.line(); line++) {
+            score += board.cell(line, column) == active ? weight : -weight;
+        }
+    }
+
+    return score;
+}
+
+void Negamax::stop()
+{
+    _halt = true;
+}
+
+void Negamax::resume()
+{
+    _halt = false;
+}
+
+unsigned Negamax::depth() const
+{
+    return _depth;
+}
+
+void Negamax::depth(unsigned depth)
+{
+    if (depth == 0) {
+        throw std::out_of_range("Depth must be at least 1");
+    }
+    _depth = depth;
+}
+
+unsigned Negamax::threads() const
+{
+    return _threads;
+}
+
+void Negamax::threads(unsigned threads)
+{
+    if (threads == 0) {
+        throw std::out_of_range("At least one thread is needed");
+    }
+    _threads = threads;
+}
+
+unsigned Negamax::budget() const
+{
+    return _budget;
+}
+
+void Negamax::budget(unsigned milliseconds)
+{
+    _budget = milliseconds;
+}
+
+const std::shared_ptr<TranspositionTable> &Negamax::table() const
+{
+    return _table;
+}
+
+bool Negamax::symmetry() const
+{
+    return _symmetry;
+}
+
+void Negamax::symmetry(bool symmetry)
+{
+    _symmetry = symmetry;
+}
+
+MoveOrder::Heuristic Negamax::ordering() const
+{
+    return _ordering;
+}
+
+void Negamax::ordering(MoveOrder::Heuristic heuristic)
+{
+    _ordering = heuristic;
+}
+
+const std::shared_ptr<const OpeningBook> &Negamax::book() const
+{
+    return _book;
+}
+
+void Negamax::book(std::shared_ptr<const OpeningBook> book)
+{
+    _book = book;
+}
+
+const SearchStats &Negamax::stats() const
+{
+    return _stats;
+}
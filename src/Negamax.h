@@ -0,0 +1,276 @@
+/*! \file Negamax.h
+ * Negamax class definition
+ */
+
+#ifndef NEGAMAX_H
+#define NEGAMAX_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Engine.h"
+#include "BitBoard.h"
+#include "ConnectN.h"
+#include "MoveOrder.h"
+#include "OpeningBook.h"
+#include "TranspositionTable.h"
+
+/*!
+ * \brief Statistics of a search
+ */
+struct SearchStats
+{
+    std::uint64_t nodes; /*!< number of positions visited */
+    std::uint64_t probes; /*!< number of transposition table lookups */
+    std::uint64_t hits; /*!< number of results found in the table */
+    double seconds; /*!< time spent searching */
+    unsigned depth; /*!< depth of the last completed iteration */
+    std::vector<double> iterations; /*!< time spent on each completed depth */
+    bool book; /*!< the move was read from the opening book */
+
+    /*!
+     * \brief Return the search speed
+     * \return the number of positions visited per second
+     */
+    double nodesPerSecond() const;
+
+    /*!
+     * \brief Return the share of successful table lookups
+     * \return hits / probes, 0 if nothing was probed
+     */
+    double hitRate() const;
+};
+
+/*!
+ * \brief An alpha-beta negamax engine.
+ * The search makes and takes back moves on a single copy of the game. It is
+ * deepened one move at a time up to a maximum depth, each iteration trying
+ * the principal variation of the previous one first. With a time budget, the
+ * search stops when the budget is spent, and the move of the last completed
+ * iteration is played, as when the search is stopped from another thread.
+ * Wins are scored by how soon they happen; other positions at the search
+ * horizon are scored by how close to the center the pieces are.
+ * Results are kept in an optional transposition table, which can be shared
+ * with other searches on boards of the same size.
+ *
+ * With more than one thread and a transposition table, the search is a Lazy
+ * SMP: helper threads search the same root, each on its own copy of the
+ * game, some of them one move deeper, and fill the shared table with results
+ * the main thread then reuses. The move of the main thread is played. The
+ * state of the threads is made in the Arena of the thread calling
+ * bestMove(), so that a single-threaded search does not call the global
+ * allocator once it has been warmed up.
+ *
+ * With an opening book, positions found in the book are not searched: the
+ * move of the book is played.
+ *
+ * Moves are ordered by a MoveOrder, by default with the THREATS heuristic:
+ * immediate wins and forced blocks are the only moves searched when there
+ * are some, and moves letting the opponent win right above are pruned. The
+ * principal variation and the move of the table come first otherwise.
+ *
+ * With symmetry on, a position and its mirror share their table entries:
+ * the table is keyed by ConnectN::canonicalHash(), and the move stored for
+ * a mirrored position is mirrored back. Scores do not depend on the side of
+ * the board, so the results are the same, with fewer positions to search.
+ */
+class Negamax : public Engine
+{
+public:
+    /*!
+     * \brief Score of a win on the next move
+     */
+    static const int WIN_SCORE = 1000000;
+
+    /*!
+     * \brief Default search depth
+     */
+    static const unsigned DEFAULT_DEPTH = 6;
+
+    /*!
+     * \brief Maximum length of a principal variation
+     */
+    static const unsigned MAX_PV = 64;
+
+    /*!
+     * \brief Minimum remaining depth at which moves are ordered by the
+     * threats they leave; closer to the horizon, counting them costs more
+     * than the cuts it brings
+     */
+    static const unsigned SCORED_DEPTH = 3;
+
+private:
+    /* State of one search thread */
+    struct Worker
+    {
+        ConnectN game;
+        unsigned rootMoves;
+        unsigned best;
+        std::uint64_t nodes;
+        std::uint64_t probes;
+        std::uint64_t hits;
+        bool main;
+        bool followPv;
+        unsigned pvLength;
+        std::array<unsigned char, MAX_PV> pv;
+        std::array<std::array<unsigned char, MAX_PV>, MAX_PV> pvTable;
+        std::array<unsigned char, MAX_PV> pvLengths;
+    };
+
+    unsigned _depth;
+    unsigned _budget;
+    std::chrono::steady_clock::time_point _deadline;
+    unsigned _threads;
+    std::shared_ptr<TranspositionTable> _table;
+    std::shared_ptr<const OpeningBook> _book;
+    bool _symmetry;
+    unsigned _columns;
+    MoveOrder::Heuristic _ordering;
+    MoveOrder _moveOrder;
+    std::atomic<bool> _stop;
+    std::atomic<bool> _halt;
+    SearchStats _stats;
+
+    /* Search the game of the worker, from the point of view of the active
+     * player; the score is meaningless once the search is stopped */
+    int negamax(Worker &worker, unsigned depth, int alpha, int beta);
+
+    /* Deepen the search of the worker, from the given depth until maxDepth
+     * or until stopped; the main worker also records the iterations in the
+     * statistics */
+    void iterate(Worker &worker, unsigned depth, unsigned maxDepth);
+
+    /* Clear the statistics for a new search */
+    void resetStats();
+
+    /* Score a position at the horizon for the active player */
+    int evaluate(const ConnectN &game) const;
+
+public:
+    /*!
+     * \brief Negamax constructor
+     * \param depth maximum number of moves to look ahead
+     * \param table the transposition table to use, if any
+     * \param threads number of search threads; without a table, only one
+     * thread is used
+     * \throw std::out_of_range if depth or threads is 0
+     */
+    Negamax(unsigned depth = DEFAULT_DEPTH,
+            std::shared_ptr<TranspositionTable> table = nullptr,
+            unsigned threads = 1);
+
+    /*!
+     * \brief Choose the column where the active player should play.
+     * \param game a started, not finished game
+     * \return the column with the best score
+     */
+    unsigned bestMove(const ConnectN &game) override;
+
+    /*!
+     * \brief Ask the running search, from another thread, to return the
+     * move of its last completed iteration. The first iteration is always
+     * completed. The request holds until resume() is called, so that a
+     * search starting right after the request stops too.
+     */
+    void stop();
+
+    /*!
+     * \brief Withdraw a stop request, so that the next searches run to
+     * their depth or budget
+     */
+    void resume();
+
+    /*!
+     * \brief Return the maximum search depth
+     * \return the maximum number of moves to look ahead
+     */
+    unsigned depth() const;
+
+    /*!
+     * \brief Set the maximum search depth
+     * \param depth maximum number of moves to look ahead
+     * \throw std::out_of_range if depth is 0
+     */
+    void depth(unsigned depth);
+
+    /*!
+     * \brief Return the time budget
+     * \return the time budget of a search in milliseconds, 0 if unlimited
+     */
+    unsigned budget() const;
+
+    /*!
+     * \brief Set the time budget.
+     * The first iteration is always completed, whatever the budget.
+     * \param milliseconds the time budget of a search, 0 for no limit
+     */
+    void budget(unsigned milliseconds);
+
+    /*!
+     * \brief Return the number of search threads
+     * \return the number of search threads
+     */
+    unsigned threads() const;
+
+    /*!
+     * \brief Set the number of search threads
+     * \param threads number of search threads
+     * \throw std::out_of_range if threads is 0
+     */
+    void threads(unsigned threads);
+
+    /*!
+     * \brief Return the transposition table
+     * \return the transposition table, `nullptr` if none is used
+     */
+    const std::shared_ptr<TranspositionTable> &table() const;
+
+    /*!
+     * \brief Check if mirrored positions share their table entries
+     * \return `true` if the table is keyed by canonical hashes
+     */
+    bool symmetry() const;
+
+    /*!
+     * \brief Make mirrored positions share their table entries or not
+     * \param symmetry `true` to key the table by canonical hashes
+     */
+    void symmetry(bool symmetry);
+
+    /*!
+     * \brief Return the move ordering heuristic
+     * \return the heuristic ordering the moves of each position
+     */
+    MoveOrder::Heuristic ordering() const;
+
+    /*!
+     * \brief Set the move ordering heuristic
+     * \param heuristic the heuristic ordering the moves of each position
+     */
+    void ordering(MoveOrder::Heuristic heuristic);
+
+    /*!
+     * \brief Return the opening book
+     * \return the opening book, `nullptr` if none is used
+     */
+    const std::shared_ptr<const OpeningBook> &book() const;
+
+    /*!
+     * \brief Set the opening book; it can be shared with other searches
+     * \param book the opening book to use, `nullptr` for none
+     */
+    void book(std::shared_ptr<const OpeningBook> book);
+
+    /*!
+     * \brief Return the statistics of the last search
+     * \return the statistics of the last search, nodes of all the threads
+     * included
+     */
+    const SearchStats &stats() const;
+};
+
+#endif // NEGAMAX_H
@@ -0,0 +1,144 @@
+/*! \file NodePool.h
+ * NodePool class definition
+ */
+
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/*!
+ * \brief A fixed-size pool of search tree nodes.
+ * Nodes are handed out as runs of consecutive nodes, known by the index of
+ * the first, from a single array; several threads can take nodes at the
+ * same time. Nodes are never given back one by one: reset() empties the
+ * whole pool for the next tree. The array is only reallocated when a larger
+ * capacity is reserved, so that a pool reused from search to search, or
+ * from game to game through local(), no longer calls the system allocator.
+ * \param T the type of the nodes, default constructible
+ */
+template <class T>
+class NodePool
+{
+private:
+    std::unique_ptr<T[]> _nodes;
+    unsigned _capacity;
+    std::atomic<unsigned> _size;
+    std::uint64_t _allocations;
+
+public:
+    /*!
+     * \brief NodePool constructor. No memory is allocated until reserved.
+     */
+    NodePool() :
+        _nodes(),
+        _capacity(0),
+        _size(0),
+        _allocations(0)
+    { }
+
+    NodePool(const NodePool &) = delete;
+    NodePool &operator=(const NodePool &) = delete;
+
+    /*!
+     * \brief Make room for a number of nodes, and empty the pool. Not
+     * thread-safe.
+     * \param capacity the least number of nodes the pool must hold
+     * \throw std::bad_alloc if the nodes cannot be allocated
+     */
+    void reserve(unsigned capacity)
+    {
+        if (capacity > _capacity) {
+            _nodes.reset();
+            _capacity = 0;
+            _nodes.reset(new T[capacity]);
+            _capacity = capacity;
+            _allocations++;
+        }
+        _size = 0;
+    }
+
+    /*!
+     * \brief Empty the pool, keeping its nodes for the next tree. Not
+     * thread-safe.
+     */
+    void reset()
+    {
+        _size = 0;
+    }
+
+    /*!
+     * \brief Take consecutive nodes. Their content is the one left by their
+     * previous use. Thread-safe.
+     * \param count the number of nodes
+     * \param first set to the index of the first node taken
+     * \return true, false if the pool is exhausted
+     */
+    bool allocate(unsigned count, unsigned &first)
+    {
+        first = _size.fetch_add(count);
+        return first + count <= _capacity;
+    }
+
+    /*!
+     * \brief Return a node
+     * \param node the index of a node taken
+     * \return the node
+     */
+    T &operator[](unsigned node)
+    {
+        return _nodes[node];
+    }
+
+    /*!
+     * \brief Return a node
+     * \param node the index of a node taken
+     * \return the node
+     */
+    const T &operator[](unsigned node) const
+    {
+        return _nodes[node];
+    }
+
+    /*!
+     * \brief Return the number of nodes taken
+     * \return the number of nodes taken since the pool was emptied
+     */
+    unsigned size() const
+    {
+        return std::min(unsigned(_size), _capacity);
+    }
+
+    /*!
+     * \brief Return the number of nodes of the pool
+     * \return the number of nodes the pool can hold
+     */
+    unsigned capacity() const
+    {
+        return _capacity;
+    }
+
+    /*!
+     * \brief Return the number of calls to the system allocator
+     * \return the number of times the nodes were allocated
+     */
+    std::uint64_t allocations() const
+    {
+        return _allocations;
+    }
+
+    /*!
+     * \brief Return the pool of the calling thread
+     * \return the pool of the calling thread, freed when the thread ends
+     */
+    static NodePool &local()
+    {
+        static thread_local NodePool pool;
+        return pool;
+    }
+};
+
+#endif // NODEPOOL_H
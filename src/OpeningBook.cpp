@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "OpeningBook.h"
+#include "ConnectN.h"
+
+/* The low byte of an entry holds the move, the others the hash */
+static const std::uint64_t MOVE_MASK = 0xff;
+
+static const char MAGIC[4] = { 'C', 'N', 'O', 'B' };
+
+OpeningBook::OpeningBook(const std::string &path) :
+    _data(nullptr),
+    _bytes(0),
+    _power(0),
+    _line(0),
+    _column(0),
+    _entries(nullptr),
+    _size(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path + ": "
+                                 + std::strerror(errno));
+    }
+    struct stat status;
+    if (fstat(fd, &status) < 0 || status.st_size < off_t(HEADER)) {
+        close(fd);
+        throw std::runtime_error("Not an opening book: " + path);
+    }
+    _bytes = status.st_size;
+    _data = mmap(nullptr, _bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (_data == MAP_FAILED) {
+        throw std::runtime_error("Cannot map " + path + ": "
+                                 + std::strerror(errno));
+    }
+
+    const unsigned char *header = static_cast<const unsigned char *>(_data);
+    std::uint64_t size;
+    std::memcpy(&size, header + 8, sizeof(size));
+    if (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0
+            || header[4] != VERSION
+            || (_bytes - HEADER) % sizeof(std::uint64_t) != 0
+            || size != (_bytes - HEADER) / sizeof(std::uint64_t)) {
+        munmap(_data, _bytes);
+        throw std::runtime_error("Not an opening book: " + path);
+    }
+    _power = header[5];
+    _line = header[6];
+    _column = header[7];
+    _entries = reinterpret_cast<const std::uint64_t *>(header + HEADER);
+    _size = size;
+}
+
+OpeningBook::~OpeningBook()
+{
+    munmap(_data, _bytes);
+}
+
+bool OpeningBook::find(std::uint64_t hash, unsigned &column) const
+{
+    std::uint64_t key = hash & ~MOVE_MASK;
+    const std::uint64_t *end = _entries + _size;
+    const std::uint64_t *entry = std::lower_bound(_entries, end, key,
+    [](std::uint64_t a, std::uint64_t b) {
+        return (a & ~MOVE_MASK) < b;
+    });
+    if (entry == end || (*entry & ~MOVE_MASK) != key) {
+        return false;
+    }
+    column = *entry & MOVE_MASK;
+    return true;
+}
+
+bool OpeningBook::probe(const ConnectN &game, unsigned &column) const
+{
+    if (game.power() != _power || game.line() != _line
+            || game.column() != _column) {
+        return false;
+    }
+
+    unsigned move;
+    if (!find(game.hash(), move)) {
+        /* a symmetric book only holds the mirror of the position */
+        if (game.mirrorHash() == game.hash()
+                || !find(game.mirrorHash(), move)) {
+            return false;
+        }
+        move = game.mirror(move);
+    }
+
+    /* a hash collision must not lead to an illegal move */
+    if (move >= _column || !game.bitBoard().playable(move)) {
+        return false;
+    }
+    column = move;
+    return true;
+}
+
+unsigned OpeningBook::power() const
+{
+    return _power;
+}
+
+unsigned OpeningBook::line() const
+{
+    return _line;
+}
+
+unsigned OpeningBook::column() const
+{
+    return _column;
+}
+
+std::size_t OpeningBook::size() const
+{
+    return _size;
+}
+
+void OpeningBook::write(const std::string &path, unsigned power,
+                        unsigned line, unsigned column,
+                        std::vector<std::pair<std::uint64_t, unsigned>> moves)
+{
+    std::vector<std::uint64_t> entries;
+    for (const auto &move : moves) {
+        entries.push_back((move.first & ~MOVE_MASK) | move.second);
+    }
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end(),
+    [](std::uint64_t a, std::uint64_t b) {
+        return (a & ~MOVE_MASK) == (b & ~MOVE_MASK);
+    }), entries.end());
+
+    unsigned char header[HEADER];
+    std::uint64_t size = entries.size();
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    header[4] = VERSION;
+    header[5] = power;
+    header[6] = line;
+    header[7] = column;
+    std::memcpy(header + 8, &size, sizeof(size));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(header), HEADER);
+    file.write(reinterpret_cast<const char *>(entries.data()),
+               entries.size() * sizeof(std::uint64_t));
+    file.close();
+    if (!file) {
+        throw std::runtime_error("Cannot write " + path);
+    }
+}
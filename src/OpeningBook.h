@@ -0,0 +1,133 @@
+/*! \file OpeningBook.h
+ * OpeningBook class definition
+ */
+
+#ifndef OPENINGBOOK_H
+#define OPENINGBOOK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class ConnectN;
+
+/*!
+ * \brief A read-only opening book, mapped from a file.
+ * A book holds the best move of many positions of one board configuration
+ * (power, lines and columns), keyed by the Zobrist hash of ConnectN. The
+ * file is mapped in memory rather than read, so that opening a book costs
+ * nothing and several processes share its pages; positions are then found
+ * by binary search.
+ *
+ * The file is made of a 16-byte header and of sorted 64-bit entries, in the
+ * byte order of the machine:
+ *
+ *     offset  size  content
+ *          0     4  "CNOB"
+ *          4     1  format version, VERSION
+ *          5     1  power
+ *          6     1  number of lines
+ *          7     1  number of columns
+ *          8     8  number of entries
+ *         16   8*n  entries: high 56 bits of the hash, then the move
+ *
+ * A position missing from the book is looked for as its mirror, the board
+ * with its columns in reverse order, and the move found is mirrored back:
+ * a symmetric book, holding one position of each mirrored pair keyed by
+ * ConnectN::canonicalHash(), answers for both with half the entries.
+ *
+ * Books are built by the connectn_book tool.
+ */
+class OpeningBook
+{
+public:
+    /*!
+     * \brief Version of the file format
+     */
+    static const unsigned VERSION = 1;
+
+    /*!
+     * \brief Size of the file header, in bytes
+     */
+    static const std::size_t HEADER = 16;
+
+private:
+    void *_data;
+    std::size_t _bytes;
+    unsigned _power;
+    unsigned _line;
+    unsigned _column;
+    const std::uint64_t *_entries;
+    std::size_t _size;
+
+    /* Binary search of the move of a hash */
+    bool find(std::uint64_t hash, unsigned &column) const;
+
+public:
+    /*!
+     * \brief OpeningBook constructor. Map a book file.
+     * \param path the path of the book
+     * \throw std::runtime_error if the file cannot be mapped or is not a
+     * valid book
+     */
+    explicit OpeningBook(const std::string &path);
+
+    /*!
+     * \brief OpeningBook destructor. Unmap the file.
+     */
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook &) = delete;
+    OpeningBook &operator=(const OpeningBook &) = delete;
+
+    /*!
+     * \brief Look for the move of a game in the book
+     * \param game the game
+     * \param column filled with the move of the book if found
+     * \return `true` if the book has the configuration and the position of
+     * the game or its mirror, `false` otherwise
+     */
+    bool probe(const ConnectN &game, unsigned &column) const;
+
+    /*!
+     * \brief Return the number of pieces to align
+     * \return the power of the book
+     */
+    unsigned power() const;
+
+    /*!
+     * \brief Return the number of lines
+     * \return the number of lines of the book
+     */
+    unsigned line() const;
+
+    /*!
+     * \brief Return the number of columns
+     * \return the number of columns of the book
+     */
+    unsigned column() const;
+
+    /*!
+     * \brief Return the number of positions
+     * \return the number of positions in the book
+     */
+    std::size_t size() const;
+
+    /*!
+     * \brief Write a book file
+     * \param path the path of the book
+     * \param power number of pieces to align
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     * \param moves the hash of each position and its move; when two hashes
+     * only differ by their low 8 bits, one of them is kept
+     * \throw std::runtime_error if the file cannot be written
+     */
+    static void write(const std::string &path, unsigned power, unsigned line,
+                      unsigned column,
+                      std::vector<std::pair<std::uint64_t, unsigned>> moves);
+};
+
+#endif // OPENINGBOOK_H
@@ -4,6 +4,9 @@ Player::Player(const std::string &name) :
     _name(name)
 { }
 
+Player::~Player()
+{ }
+
 const std::string &Player::name() const
 {
     return _name;
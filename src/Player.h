@@ -26,6 +26,11 @@ public:
      */
     Player(const std::string &name);
 
+    /*!
+     * \brief Player destructor
+     */
+    virtual ~Player();
+
     /*!
      * \brief Return the name of the player
      * \return the name of the player
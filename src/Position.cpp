@@ -0,0 +1,15 @@
+#include "Position.h"
+#include "ConnectN.h"
+
+Position::Position() :
+    board(ConnectN::DEFAULT_LINE, ConnectN::DEFAULT_COLUMN),
+    hash(0),
+    mirrorHash(0),
+    history(),
+    moves(0),
+    power(ConnectN::DEFAULT_POWER),
+    color(Color::BLACK),
+    active(0),
+    winner(0),
+    finished(false)
+{ }
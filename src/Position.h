@@ -0,0 +1,50 @@
+/*! \file Position.h
+ * Position struct definition
+ */
+
+#ifndef POSITION_H
+#define POSITION_H
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "BitBoard.h"
+#include "Color.h"
+
+/*!
+ * \brief The whole state of a started game, as a plain value.
+ * A position holds everything a ConnectN needs to go on playing, undoing
+ * included, in a fixed size and without pointers: the players are only
+ * known by their index in ConnectN::players(). It can therefore be copied
+ * with memcpy, stored in arrays, arenas and lock-free queues, and sent
+ * between threads, as a cheap snapshot of a game. Positions are made by
+ * ConnectN::position() and turned back into games by the ConnectN
+ * constructor taking a position and two players.
+ */
+struct Position
+{
+    BitBoard board; /*!< the pieces and the size of the board */
+    std::uint64_t hash; /*!< ConnectN::hash() */
+    std::uint64_t mirrorHash; /*!< ConnectN::mirrorHash() */
+    /*! the columns played; only the first `moves` are meaningful */
+    std::array<unsigned char, BitBoard::MAX_LINE * BitBoard::MAX_COLUMN> history;
+    std::uint16_t moves; /*!< number of pieces played */
+    unsigned char power; /*!< number of pieces to align */
+    Color color; /*!< color of players()[0] */
+    unsigned char active; /*!< index in players() of the player to move */
+    unsigned char winner; /*!< 1 + index in players() of the winner, 0 if
+                               none */
+    bool finished; /*!< the game is over */
+
+    /*!
+     * \brief Default Position constructor: an empty default board, where
+     * players()[0] plays BLACK and moves first
+     */
+    Position();
+};
+
+static_assert(std::is_trivially_copyable<Position>::value,
+              "A Position must be copyable with memcpy");
+
+#endif // POSITION_H
@@ -0,0 +1,21 @@
+#include <random>
+
+#include "Random.h"
+
+Random::Random(std::uint64_t seed) :
+    _state()
+{
+    /* splitmix64 never gives an all-zero state */
+    for (auto &word : _state) {
+        std::uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        word = z ^ (z >> 31);
+    }
+}
+
+std::uint64_t Random::randomSeed()
+{
+    std::random_device device;
+    return (std::uint64_t(device()) << 32) ^ device();
+}
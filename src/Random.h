@@ -0,0 +1,111 @@
+/*! \file Random.h
+ * Random class definition
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/*!
+ * \brief A seedable pseudo-random generator: xoshiro256**.
+ * Each game or engine owns its generator, so that games can be played on
+ * several threads without sharing any state, and a given seed always gives
+ * the same numbers. The state is expanded from the seed with splitmix64.
+ * A Random is a UniformRandomBitGenerator and can be used with the standard
+ * distributions.
+ */
+class Random
+{
+public:
+    /*!
+     * \brief Type of the generated numbers
+     */
+    typedef std::uint64_t result_type;
+
+private:
+    std::array<std::uint64_t, 4> _state;
+
+public:
+    /*!
+     * \brief Random constructor
+     * \param seed the seed of the generator
+     */
+    explicit Random(std::uint64_t seed);
+
+    /*!
+     * \brief Return a seed drawn from std::random_device, for runs that
+     * don't need to be reproduced
+     * \return a seed
+     */
+    static std::uint64_t randomSeed();
+
+    /*!
+     * \brief Return the smallest generated number
+     * \return 0
+     */
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    /*!
+     * \brief Return the largest generated number
+     * \return the largest 64-bit number
+     */
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /*!
+     * \brief Generate the next number
+     * \return a number uniformly distributed between min() and max()
+     */
+    result_type operator()();
+
+    /*!
+     * \brief Generate a number below the given bound
+     * \param bound the bound, not 0
+     * \return a number uniformly distributed between 0 and bound - 1
+     */
+    unsigned below(unsigned bound);
+};
+
+/* Random numbers are drawn on every move of a playout: keep them inline */
+
+inline Random::result_type Random::operator()()
+{
+    std::uint64_t result = _state[1] * 5;
+    result = ((result << 7) | (result >> 57)) * 9;
+    std::uint64_t t = _state[1] << 17;
+
+    _state[2] ^= _state[0];
+    _state[3] ^= _state[1];
+    _state[1] ^= _state[2];
+    _state[0] ^= _state[3];
+    _state[2] ^= t;
+    _state[3] = (_state[3] << 45) | (_state[3] >> 19);
+
+    return result;
+}
+
+inline unsigned Random::below(unsigned bound)
+{
+    /* multiply and shift, rejecting the few low products that would bias
+     * the result (Lemire) */
+    std::uint64_t product = ((*this)() >> 32) * bound;
+    std::uint32_t low = std::uint32_t(product);
+    if (low < bound) {
+        std::uint32_t threshold = std::uint32_t(-bound) % bound;
+        while (low < threshold) {
+            product = ((*this)() >> 32) * bound;
+            low = std::uint32_t(product);
+        }
+    }
+    return product >> 32;
+}
+
+#endif // RANDOM_H
@@ -0,0 +1,20 @@
+#include <cstdint>
+
+#include "RandomEngine.h"
+#include "ConnectN.h"
+
+RandomEngine::RandomEngine(std::uint64_t seed) :
+    _random(seed)
+{ }
+
+unsigned RandomEngine::bestMove(const ConnectN &game)
+{
+    std::uint32_t legal = game.legalMoves();
+    unsigned index = _random.below(__builtin_popcount(legal));
+
+    /* drop the lowest columns until the chosen one is the lowest */
+    for (unsigned i = 0; i < index; i++) {
+        legal &= legal - 1;
+    }
+    return __builtin_ctz(legal);
+}
@@ -0,0 +1,37 @@
+/*! \file RandomEngine.h
+ * RandomEngine class definition
+ */
+
+#ifndef RANDOMENGINE_H
+#define RANDOMENGINE_H
+
+#include <cstdint>
+
+#include "Engine.h"
+#include "Random.h"
+
+/*!
+ * \brief An engine playing any column where a piece can be dropped, each
+ * with the same probability
+ */
+class RandomEngine : public Engine
+{
+private:
+    Random _random;
+
+public:
+    /*!
+     * \brief RandomEngine constructor
+     * \param seed the seed of the random moves
+     */
+    RandomEngine(std::uint64_t seed);
+
+    /*!
+     * \brief Choose a random column where a piece can be dropped
+     * \param game a started, not finished game
+     * \return a random column where a piece can be dropped
+     */
+    unsigned bestMove(const ConnectN &game) override;
+};
+
+#endif // RANDOMENGINE_H
@@ -0,0 +1,62 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "RecordReader.h"
+#include "BitBoard.h"
+#include "RecordWriter.h"
+
+RecordReader::RecordReader(std::istream &in, std::size_t buffer) :
+    _in(in),
+    _buffer(buffer),
+    _begin(0),
+    _end(0),
+    _records(0)
+{
+    GameRecord largest;
+    largest.moves.resize(BitBoard::MAX_LINE * BitBoard::MAX_COLUMN);
+    if (buffer < largest.size()) {
+        throw std::invalid_argument("Record buffer too small");
+    }
+
+    unsigned char header[RecordWriter::HEADER];
+    _in.read(reinterpret_cast<char *>(header), RecordWriter::HEADER);
+    if (!_in || std::memcmp(header, "CNGR", 4) != 0
+            || header[4] != RecordWriter::VERSION) {
+        throw std::runtime_error("Not a game record stream");
+    }
+}
+
+bool RecordReader::fill()
+{
+    std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+    _end -= _begin;
+    _begin = 0;
+    _in.read(reinterpret_cast<char *>(_buffer.data() + _end),
+             _buffer.size() - _end);
+    _end += _in.gcount();
+    return _in.gcount() > 0;
+}
+
+bool RecordReader::next(GameRecord &record)
+{
+    std::size_t size = GameRecord::decode(_buffer.data() + _begin,
+                                          _end - _begin, record);
+    if (size == 0) {
+        if (!fill() && _begin == _end) {
+            return false;
+        }
+        size = GameRecord::decode(_buffer.data() + _begin, _end - _begin,
+                                  record);
+        if (size == 0) {
+            throw std::runtime_error("Truncated game record");
+        }
+    }
+    _begin += size;
+    _records++;
+    return true;
+}
+
+std::uint64_t RecordReader::records() const
+{
+    return _records;
+}
@@ -0,0 +1,70 @@
+/*! \file RecordReader.h
+ * RecordReader class definition
+ */
+
+#ifndef RECORDREADER_H
+#define RECORDREADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#include "GameRecord.h"
+
+/*!
+ * \brief A buffered reader of the game records written by RecordWriter.
+ * The stream is read by large blocks and the records are decoded in place,
+ * with no text parsing; a record can then be replayed on a ConnectN with
+ * GameRecord::replay().
+ */
+class RecordReader
+{
+public:
+    /*!
+     * \brief Default size of the buffer, in bytes
+     */
+    static const std::size_t DEFAULT_BUFFER = 1 << 16;
+
+private:
+    std::istream &_in;
+    std::vector<unsigned char> _buffer;
+    std::size_t _begin;
+    std::size_t _end;
+    std::uint64_t _records;
+
+    /* Move the unread bytes to the front of the buffer and fill the rest;
+     * return false if nothing could be read */
+    bool fill();
+
+public:
+    /*!
+     * \brief RecordReader constructor. Read the stream header.
+     * \param in the stream to read from, opened in binary mode
+     * \param buffer the size of the buffer, in bytes
+     * \throw std::invalid_argument if the buffer cannot hold the largest
+     * record
+     * \throw std::runtime_error if the stream is not a record stream
+     */
+    RecordReader(std::istream &in, std::size_t buffer = DEFAULT_BUFFER);
+
+    RecordReader(const RecordReader &) = delete;
+    RecordReader &operator=(const RecordReader &) = delete;
+
+    /*!
+     * \brief Read the next record
+     * \param record filled with the record; its move vector is reused, so
+     * that reading a stream into a single record allocates nothing
+     * \return `true` if a record was read, `false` at the end of the stream
+     * \throw std::runtime_error if the stream ends within a record
+     */
+    bool next(GameRecord &record);
+
+    /*!
+     * \brief Return the number of records read
+     * \return the number of records read
+     */
+    std::uint64_t records() const;
+};
+
+#endif // RECORDREADER_H
@@ -0,0 +1,63 @@
+#include <stdexcept>
+
+#include "RecordWriter.h"
+#include "BitBoard.h"
+#include "ConnectN.h"
+
+RecordWriter::RecordWriter(std::ostream &out, std::size_t buffer) :
+    _out(out),
+    _buffer(buffer),
+    _used(0),
+    _records(0)
+{
+    GameRecord largest;
+    largest.moves.resize(BitBoard::MAX_LINE * BitBoard::MAX_COLUMN);
+    if (buffer < largest.size()) {
+        throw std::invalid_argument("Record buffer too small");
+    }
+
+    const unsigned char header[HEADER] = { 'C', 'N', 'G', 'R', VERSION, 0, 0, 0 };
+    _out.write(reinterpret_cast<const char *>(header), HEADER);
+    if (!_out) {
+        throw std::runtime_error("Cannot write the record stream");
+    }
+}
+
+RecordWriter::~RecordWriter()
+{
+    try {
+        flush();
+    } catch (const std::exception &) {
+    }
+}
+
+void RecordWriter::write(const ConnectN &game)
+{
+    write(GameRecord::of(game));
+}
+
+void RecordWriter::write(const GameRecord &record)
+{
+    std::size_t size = record.size();
+    if (_used + size > _buffer.size()) {
+        flush();
+    }
+    record.encode(_buffer.data() + _used);
+    _used += size;
+    _records++;
+}
+
+void RecordWriter::flush()
+{
+    _out.write(reinterpret_cast<const char *>(_buffer.data()), _used);
+    _used = 0;
+    _out.flush();
+    if (!_out) {
+        throw std::runtime_error("Cannot write the record stream");
+    }
+}
+
+std::uint64_t RecordWriter::records() const
+{
+    return _records;
+}
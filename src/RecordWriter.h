@@ -0,0 +1,96 @@
+/*! \file RecordWriter.h
+ * RecordWriter class definition
+ */
+
+#ifndef RECORDWRITER_H
+#define RECORDWRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "GameRecord.h"
+
+class ConnectN;
+
+/*!
+ * \brief A buffered writer of game records.
+ * A record stream starts with an 8-byte header, "CNGR", the format version
+ * and three zero bytes, followed by GameRecord entries back to back.
+ * Records are encoded into a buffer that is written to the stream when full,
+ * so that archiving a game costs no stream call. A writer is not thread
+ * safe.
+ */
+class RecordWriter
+{
+public:
+    /*!
+     * \brief Version of the stream format
+     */
+    static const unsigned VERSION = 1;
+
+    /*!
+     * \brief Size of the stream header, in bytes
+     */
+    static const std::size_t HEADER = 8;
+
+    /*!
+     * \brief Default size of the buffer, in bytes
+     */
+    static const std::size_t DEFAULT_BUFFER = 1 << 16;
+
+private:
+    std::ostream &_out;
+    std::vector<unsigned char> _buffer;
+    std::size_t _used;
+    std::uint64_t _records;
+
+public:
+    /*!
+     * \brief RecordWriter constructor. Write the stream header.
+     * \param out the stream to write to, opened in binary mode
+     * \param buffer the size of the buffer, in bytes
+     * \throw std::invalid_argument if the buffer cannot hold the largest
+     * record
+     */
+    RecordWriter(std::ostream &out, std::size_t buffer = DEFAULT_BUFFER);
+
+    /*!
+     * \brief RecordWriter destructor. Write the buffered records; errors are
+     * ignored, call flush() to see them.
+     */
+    ~RecordWriter();
+
+    RecordWriter(const RecordWriter &) = delete;
+    RecordWriter &operator=(const RecordWriter &) = delete;
+
+    /*!
+     * \brief Record a game
+     * \param game a started game
+     * \throw std::logic_error if the game is not started
+     * \throw std::runtime_error if the stream fails
+     */
+    void write(const ConnectN &game);
+
+    /*!
+     * \brief Write a record
+     * \param record the record
+     * \throw std::runtime_error if the stream fails
+     */
+    void write(const GameRecord &record);
+
+    /*!
+     * \brief Write the buffered records to the stream and flush it
+     * \throw std::runtime_error if the stream fails
+     */
+    void flush();
+
+    /*!
+     * \brief Return the number of records written
+     * \return the number of records written
+     */
+    std::uint64_t records() const;
+};
+
+#endif // RECORDWRITER_H
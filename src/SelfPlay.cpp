@@ -0,0 +1,140 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "SelfPlay.h"
+#include "ComputerPlayer.h"
+#include "ConnectN.h"
+#include "GameRecord.h"
+#include "GreedyEngine.h"
+#include "Mcts.h"
+#include "Negamax.h"
+#include "RandomEngine.h"
+#include "libs/stringConvert.hpp"
+
+double MatchResult::gamesPerSecond() const
+{
+    return seconds > 0 ? games / seconds : 0;
+}
+
+std::unique_ptr<Engine> SelfPlay::createEngine(const std::string &specification,
+                                               std::uint64_t seed)
+{
+    if (specification == "random") {
+        return std::unique_ptr<Engine>(new RandomEngine(seed));
+    }
+    if (specification == "greedy") {
+        return std::unique_ptr<Engine>(new GreedyEngine(seed));
+    }
+    if (specification == "search") {
+        return std::unique_ptr<Engine>(new Negamax());
+    }
+    if (specification.compare(0, 7, "search:") == 0) {
+        unsigned depth;
+        try {
+            depth = nvs::fromString<unsigned>(specification.substr(7));
+        } catch (const nvs::bad_string_convert &) {
+            throw std::invalid_argument("Bad search depth: " + specification);
+        }
+        return std::unique_ptr<Engine>(new Negamax(depth));
+    }
+    if (specification == "mcts") {
+        return std::unique_ptr<Engine>(new Mcts(Mcts::DEFAULT_PLAYOUTS, 1, seed));
+    }
+    if (specification.compare(0, 5, "mcts:") == 0) {
+        unsigned playouts;
+        try {
+            playouts = nvs::fromString<unsigned>(specification.substr(5));
+        } catch (const nvs::bad_string_convert &) {
+            throw std::invalid_argument("Bad playout count: " + specification);
+        }
+        return std::unique_ptr<Engine>(new Mcts(playouts, 1, seed));
+    }
+    throw std::invalid_argument("Unknown engine: " + specification);
+}
+
+SelfPlay::SelfPlay(const std::string &first, const std::string &second,
+                   unsigned threads) :
+    _first(first),
+    _second(second),
+    _pool(threads),
+    _writer(nullptr),
+    _writerMutex()
+{
+    createEngine(first, 0);
+    createEngine(second, 0);
+}
+
+MatchResult SelfPlay::play(unsigned power, unsigned line, unsigned column,
+                           unsigned games, std::uint64_t seed)
+{
+    std::atomic<unsigned> wins(0);
+    std::atomic<unsigned> losses(0);
+    std::atomic<unsigned> draws(0);
+    std::atomic<bool> unrecorded(false);
+    std::atomic<bool> illegal(false);
+    auto start = std::chrono::steady_clock::now();
+
+    /* fail here rather than in the pool */
+    ConnectN(power, line, column);
+
+    for (unsigned i = 0; i < games; i++) {
+        _pool.submit([this, power, line, column, seed, i,
+                     &wins, &losses, &draws, &unrecorded, &illegal]() {
+            std::uint64_t gameSeed = seed + 3 * std::uint64_t(i);
+            ComputerPlayer first("first", createEngine(_first, gameSeed + 1));
+            ComputerPlayer second("second", createEngine(_second,
+                                                         gameSeed + 2));
+            ConnectN game(power, line, column, gameSeed);
+            game.enroll(&first);
+            game.enroll(&second);
+
+            while (!game.finished()) {
+                const ComputerPlayer &active =
+                        game.activePlayer() == &first ? first : second;
+                /* an engine playing illegally forfeits the series */
+                if (game.tryPlay(active.play(game))
+                        != ConnectN::MoveStatus::PLAYED) {
+                    illegal = true;
+                    return;
+                }
+            }
+
+            if (game.winner() == &first) {
+                wins++;
+            } else if (game.winner() == &second) {
+                losses++;
+            } else {
+                draws++;
+            }
+
+            if (_writer != nullptr) {
+                /* the record of each thread is reused from game to game */
+                static thread_local GameRecord record;
+                GameRecord::of(game, record);
+                std::lock_guard<std::mutex> lock(_writerMutex);
+                try {
+                    _writer->write(record);
+                } catch (const std::exception &) {
+                    unrecorded = true;
+                }
+            }
+        });
+    }
+    _pool.wait();
+    if (illegal) {
+        throw std::logic_error("An engine played an illegal move");
+    }
+    if (unrecorded) {
+        throw std::runtime_error("Cannot record the games");
+    }
+
+    double seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+    return MatchResult{games, wins, losses, draws, seconds};
+}
+
+void SelfPlay::record(RecordWriter *writer)
+{
+    _writer = writer;
+}
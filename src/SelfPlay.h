@@ -0,0 +1,109 @@
+/*! \file SelfPlay.h
+ * SelfPlay class definition
+ */
+
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "Engine.h"
+#include "RecordWriter.h"
+#include "ThreadPool.h"
+
+/*!
+ * \brief Results of a series of games, from the point of view of the first
+ * engine
+ */
+struct MatchResult
+{
+    unsigned games; /*!< number of games played */
+    unsigned wins; /*!< games won by the first engine */
+    unsigned losses; /*!< games won by the second engine */
+    unsigned draws; /*!< games without winner */
+    double seconds; /*!< time spent playing */
+
+    /*!
+     * \brief Return the speed of the series
+     * \return the number of games played per second
+     */
+    double gamesPerSecond() const;
+};
+
+/*!
+ * \brief Headless games between two engines.
+ * Games are played without any input or output, spread over a pool of
+ * threads. Each game has its own engines, created from a specification:
+ *   * `random`: RandomEngine
+ *   * `greedy`: GreedyEngine
+ *   * `search` or `search:D`: Negamax looking D moves ahead, without
+ *     transposition table
+ *   * `mcts` or `mcts:P`: Mcts playing P playouts per move, on one thread
+ *
+ * Colors, the first player and the random moves are drawn from seeds
+ * derived from the seed of the series and the index of the game.
+ *
+ * Finished games can be archived with a RecordWriter, in the order they
+ * end; the first engine is players()[0] of each record.
+ */
+class SelfPlay
+{
+private:
+    std::string _first;
+    std::string _second;
+    ThreadPool _pool;
+    RecordWriter *_writer;
+    std::mutex _writerMutex;
+
+public:
+    /*!
+     * \brief Create an engine from its specification
+     * \param specification the specification of the engine, see SelfPlay
+     * \param seed the seed of the random moves, if any
+     * \return the engine
+     * \throw std::invalid_argument if the specification is unknown
+     * \throw std::out_of_range if the depth of a search or the playouts of
+     * a Monte Carlo search are 0
+     */
+    static std::unique_ptr<Engine> createEngine(const std::string &specification,
+                                                std::uint64_t seed);
+
+    /*!
+     * \brief SelfPlay constructor
+     * \param first the specification of the first engine
+     * \param second the specification of the second engine
+     * \param threads the number of threads playing games
+     * \throw std::invalid_argument if a specification is unknown
+     * \throw std::out_of_range if threads is 0
+     */
+    SelfPlay(const std::string &first, const std::string &second,
+             unsigned threads);
+
+    /*!
+     * \brief Play a series of games
+     * \param power number of pieces to align
+     * \param line number of lines of the board
+     * \param column number of columns of the board
+     * \param games number of games to play
+     * \param seed the seed of the series: the same seed gives the same
+     * games, whatever the number of threads
+     * \return the results of the series
+     * \throw std::out_of_range if the board is not valid
+     * \throw std::runtime_error if the games cannot be recorded
+     * \throw std::logic_error if an engine plays an illegal move
+     */
+    MatchResult play(unsigned power, unsigned line, unsigned column,
+                     unsigned games, std::uint64_t seed = 0);
+
+    /*!
+     * \brief Set the writer the games are recorded to
+     * \param writer the writer, kept by the caller, `nullptr` to stop
+     * recording
+     */
+    void record(RecordWriter *writer);
+};
+
+#endif // SELFPLAY_H
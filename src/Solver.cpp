@@ -0,0 +1,448 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "Solver.h"
+#include "BitBoard.h"
+#include "ConnectN.h"
+
+/* Word operations shared by the 64-bit and the BitPlane searches */
+
+static bool none(std::uint64_t bits)
+{
+    return bits == 0;
+}
+
+static bool none(const BitPlane &bits)
+{
+    return !bits.any();
+}
+
+static unsigned count(std::uint64_t bits)
+{
+    return __builtin_popcountll(bits);
+}
+
+static unsigned count(const BitPlane &bits)
+{
+    return bits.count();
+}
+
+static std::uint64_t mix(std::uint64_t key)
+{
+    /* splitmix64 finalizer: a bijection, distinct keys stay distinct */
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+}
+
+static std::uint64_t hash(std::uint64_t current, std::uint64_t mask)
+{
+    /* current + mask is unique to a position */
+    return mix(current + mask);
+}
+
+static std::uint64_t hash(const BitPlane &current, const BitPlane &mask)
+{
+    std::uint64_t key = 0;
+    for (unsigned i = 0; i < BitPlane::WORDS; i++) {
+        key = mix(key ^ current.word(i)) + mask.word(i);
+    }
+    return mix(key);
+}
+
+static std::uint64_t up(std::uint64_t bits, unsigned shift)
+{
+    return shift < 64 ? bits << shift : 0;
+}
+
+static BitPlane up(const BitPlane &bits, unsigned shift)
+{
+    return shift < BitPlane::BITS ? bits << shift : BitPlane();
+}
+
+static std::uint64_t down(std::uint64_t bits, unsigned shift)
+{
+    return shift < 64 ? bits >> shift : 0;
+}
+
+static BitPlane down(const BitPlane &bits, unsigned shift)
+{
+    return shift < BitPlane::BITS ? bits >> shift : BitPlane();
+}
+
+static void setBit(std::uint64_t &bits, unsigned bit)
+{
+    bits |= std::uint64_t(1) << bit;
+}
+
+static void setBit(BitPlane &bits, unsigned bit)
+{
+    bits.set(bit);
+}
+
+static void load(std::uint64_t &bits, const BitPlane &plane)
+{
+    bits = plane.word(0);
+}
+
+static void load(BitPlane &bits, const BitPlane &plane)
+{
+    bits = plane;
+}
+
+/*!
+ * \brief Null-window search of a position stored on words of type Bits.
+ * The position is seen from the active player: current holds its pieces,
+ * mask all the pieces. The active player is never able to win at once in a
+ * searched position: its parent only plays moves that prevent it.
+ */
+template<typename Bits>
+class SolverSearch
+{
+private:
+    unsigned _power;
+    unsigned _line;
+    unsigned _column;
+    unsigned _cells;
+    Bits _board;
+    Bits _bottom;
+    std::array<Bits, BitBoard::MAX_COLUMN> _columns;
+    std::array<unsigned, BitBoard::MAX_COLUMN> _order;
+    TranspositionTable &_table;
+    bool _symmetry;
+    std::uint64_t _nodes;
+    std::uint64_t _probes;
+    std::uint64_t _hits;
+
+    /* The bits with the columns in reverse order */
+    Bits mirror(const Bits &bits) const
+    {
+        Bits mirrored = Bits();
+        for (unsigned c = 0; c < _column; c++) {
+            Bits column = bits & _columns[c];
+            unsigned to = _column - 1 - c;
+            if (to > c) {
+                mirrored |= up(column, (to - c) * (_line + 1));
+            } else {
+                mirrored |= down(column, (c - to) * (_line + 1));
+            }
+        }
+        return mirrored;
+    }
+
+    /* Empty cells where the pieces of position would complete an alignment */
+    Bits winning(const Bits &position, const Bits &mask) const
+    {
+        std::array<unsigned, 3> shifts{{_line + 1, _line + 2, _line}};
+        Bits cells = position;
+
+        /* vertical: only below an empty cell */
+        for (unsigned i = 1; i < _power - 1; i++) {
+            cells &= up(position, i);
+        }
+        cells = up(cells, 1);
+
+        /* horizontal and diagonals: a pieces on one side, N - 1 - a on the
+         * other; the sentinel line stops the runs at the edge of columns */
+        for (unsigned shift : shifts) {
+            std::array<Bits, ConnectN::MAX_POWER> before;
+            std::array<Bits, ConnectN::MAX_POWER> after;
+            before[0] = ~Bits();
+            after[0] = ~Bits();
+            for (unsigned i = 1; i < _power; i++) {
+                before[i] = before[i - 1] & up(position, i * shift);
+                after[i] = after[i - 1] & down(position, i * shift);
+            }
+            for (unsigned i = 0; i < _power; i++) {
+                cells |= before[i] & after[_power - 1 - i];
+            }
+        }
+
+        return cells & (_board ^ mask);
+    }
+
+    Bits possible(const Bits &mask) const
+    {
+        return (mask + _bottom) & _board;
+    }
+
+    /* Moves that do not let the opponent win at once, none if all lose */
+    Bits nonLosing(const Bits &current, const Bits &mask) const
+    {
+        Bits moves = possible(mask);
+        Bits threats = winning(current ^ mask, mask);
+        Bits forced = moves & threats;
+
+        if (!none(forced)) {
+            if (count(forced) > 1) {
+                return Bits();
+            }
+            moves = forced;
+        }
+        /* never play below a cell where the opponent would win */
+        return moves & ~down(threats, 1);
+    }
+
+    int negamax(const Bits &current, const Bits &mask, unsigned moves,
+                int alpha, int beta)
+    {
+        TranspositionTable::Entry entry;
+        std::uint64_t key = hash(current, mask);
+        std::array<Bits, BitBoard::MAX_COLUMN> children;
+        /* a position and its mirror have the same score */
+        if (_symmetry) {
+            key = std::min(key, hash(mirror(current), mirror(mask)));
+        }
+        std::array<unsigned, BitBoard::MAX_COLUMN> scores;
+        unsigned size = 0;
+
+        _nodes++;
+        Bits next = nonLosing(current, mask);
+        if (none(next)) {
+            return -int(_cells - moves) / 2;
+        }
+        if (moves >= _cells - 2) {
+            return 0;
+        }
+
+        /* the opponent cannot win at once, the active player neither */
+        int lower = -int(_cells - 2 - moves) / 2;
+        int upper = int(_cells - 1 - moves) / 2;
+        _probes++;
+        if (_table.probe(key, entry)) {
+            _hits++;
+            if (entry.bound == TranspositionTable::Bound::UPPER) {
+                upper = std::min(upper, entry.score);
+            } else if (entry.bound == TranspositionTable::Bound::LOWER) {
+                lower = std::max(lower, entry.score);
+            }
+        }
+        if (alpha < lower) {
+            alpha = lower;
+            if (alpha >= beta) {
+                return alpha;
+            }
+        }
+        if (beta > upper) {
+            beta = upper;
+            if (alpha >= beta) {
+                return beta;
+            }
+        }
+
+        /* moves creating the most threats first, central ones on ties */
+        for (unsigned i = 0; i < _column; i++) {
+            Bits move = next & _columns[_order[i]];
+            if (none(move)) {
+                continue;
+            }
+            unsigned score = count(winning(current | move, mask));
+            unsigned j = size++;
+            while (j > 0 && scores[j - 1] < score) {
+                children[j] = children[j - 1];
+                scores[j] = scores[j - 1];
+                j--;
+            }
+            children[j] = move;
+            scores[j] = score;
+        }
+
+        for (unsigned i = 0; i < size; i++) {
+            /* the opponent becomes the active player */
+            Bits childMask = mask | children[i];
+            int score = -negamax(current ^ mask, childMask, moves + 1,
+                                 -beta, -alpha);
+            if (score >= beta) {
+                _table.store(key, {score, 0, TranspositionTable::Bound::LOWER, 0});
+                return score;
+            }
+            if (score > alpha) {
+                alpha = score;
+            }
+        }
+        _table.store(key, {alpha, 0, TranspositionTable::Bound::UPPER, 0});
+
+        return alpha;
+    }
+
+public:
+    SolverSearch(unsigned power, unsigned line, unsigned column,
+                 TranspositionTable &table, bool symmetry) :
+        _power(power),
+        _line(line),
+        _column(column),
+        _cells(line * column),
+        _board(),
+        _bottom(),
+        _columns(),
+        _order(),
+        _table(table),
+        _symmetry(symmetry),
+        _nodes(0),
+        _probes(0),
+        _hits(0)
+    {
+        for (unsigned c = 0; c < column; c++) {
+            for (unsigned l = 0; l < line; l++) {
+                setBit(_columns[c], c * (line + 1) + l);
+            }
+            setBit(_bottom, c * (line + 1));
+            _board |= _columns[c];
+            _order[c] = c;
+        }
+        std::stable_sort(_order.begin(), _order.begin() + column,
+        [column](unsigned a, unsigned b) {
+            return std::abs(2 * int(a) - int(column) + 1)
+                    < std::abs(2 * int(b) - int(column) + 1);
+        });
+    }
+
+    int solve(const BitPlane &own, const BitPlane &other, unsigned moves)
+    {
+        Bits current;
+        Bits mask;
+        load(current, own);
+        load(mask, other);
+        mask |= current;
+
+        if (!none(winning(current, mask) & possible(mask))) {
+            return int(_cells + 1 - moves) / 2;
+        }
+
+        /* narrow the score with null windows, trying draws first */
+        int min = -int(_cells - moves) / 2;
+        int max = int(_cells + 1 - moves) / 2;
+        while (min < max) {
+            int median = min + (max - min) / 2;
+            if (median <= 0 && min / 2 < median) {
+                median = min / 2;
+            } else if (median >= 0 && max / 2 > median) {
+                median = max / 2;
+            }
+            int score = negamax(current, mask, moves, median, median + 1);
+            if (score <= median) {
+                max = score;
+            } else {
+                min = score;
+            }
+        }
+
+        return min;
+    }
+
+    std::uint64_t nodes() const
+    {
+        return _nodes;
+    }
+
+    std::uint64_t probes() const
+    {
+        return _probes;
+    }
+
+    std::uint64_t hits() const
+    {
+        return _hits;
+    }
+};
+
+Solver::Solver(std::size_t megabytes) :
+    _table(megabytes),
+    _symmetry(false),
+    _nodes(0),
+    _probes(0),
+    _hits(0),
+    _power(0),
+    _line(0),
+    _column(0)
+{ }
+
+Solver::Result Solver::solve(const ConnectN &game)
+{
+    if (!game.started()) {
+        throw std::logic_error("Game not yet started");
+    }
+    if (game.finished()) {
+        throw std::logic_error("Game already finished");
+    }
+
+    /* scores depend on the board size */
+    if (game.power() != _power || game.line() != _line
+            || game.column() != _column) {
+        _table.clear();
+        _power = game.power();
+        _line = game.line();
+        _column = game.column();
+    }
+
+    const BitBoard &board = game.bitBoard();
+    Color active = game.color(game.activePlayer());
+    Color other = active == Color::BLACK ? Color::WHITE : Color::BLACK;
+    unsigned cells = _line * _column;
+    unsigned moves = game.movesPlayed();
+    int score;
+
+    if ((_line + 1) * _column <= 64) {
+        SolverSearch<std::uint64_t> search(_power, _line, _column, _table,
+                                           _symmetry);
+        score = search.solve(board.plane(active), board.plane(other), moves);
+        _nodes = search.nodes();
+        _probes = search.probes();
+        _hits = search.hits();
+    } else {
+        SolverSearch<BitPlane> search(_power, _line, _column, _table,
+                                      _symmetry);
+        score = search.solve(board.plane(active), board.plane(other), moves);
+        _nodes = search.nodes();
+        _probes = search.probes();
+        _hits = search.hits();
+    }
+
+    /* a score s is reached by the winning piece played after n pieces, with
+     * (cells + 1 - n) / 2 = s and n of the winner's parity */
+    Result result{Outcome::DRAW, cells - moves, score};
+    if (score > 0) {
+        unsigned last = cells + 1 - 2 * score;
+        if (last % 2 != moves % 2) {
+            last--;
+        }
+        result.outcome = Outcome::WIN;
+        result.moves = last - moves + 1;
+    } else if (score < 0) {
+        unsigned last = cells + 1 + 2 * score;
+        if (last % 2 == moves % 2) {
+            last--;
+        }
+        result.outcome = Outcome::LOSS;
+        result.moves = last - moves + 1;
+    }
+
+    return result;
+}
+
+std::uint64_t Solver::nodes() const
+{
+    return _nodes;
+}
+
+double Solver::hitRate() const
+{
+    return _probes > 0 ? double(_hits) / _probes : 0;
+}
+
+bool Solver::symmetry() const
+{
+    return _symmetry;
+}
+
+void Solver::symmetry(bool symmetry)
+{
+    _symmetry = symmetry;
+}
+
+const TranspositionTable &Solver::table() const
+{
+    return _table;
+}
@@ -0,0 +1,114 @@
+/*! \file Solver.h
+ * Solver class definition
+ */
+
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "TranspositionTable.h"
+
+class ConnectN;
+
+/*!
+ * \brief An exact ConnectN solver.
+ * The solver finds the outcome of a position under perfect play: the
+ * winner wins as soon as possible, the loser loses as late as possible. The
+ * score is narrowed by a sequence of null-window alpha-beta searches on a
+ * bitboard, with a transposition table. Moves letting the opponent win at
+ * once are pruned, and moves creating the most threats are tried first.
+ * Boards fitting in 64 bits (sentinel line included, such as the default 6x7
+ * board) are searched on single words, larger ones on BitPlane.
+ */
+class Solver
+{
+public:
+    /*!
+     * \brief The outcome of a position, for the active player
+     */
+    enum class Outcome {
+        WIN, /*!< the active player wins */
+        DRAW, /*!< the board is filled without winner */
+        LOSS /*!< the other player wins */
+    };
+
+    /*!
+     * \brief The result of a solved position
+     */
+    struct Result
+    {
+        Outcome outcome; /*!< the outcome for the active player */
+        unsigned moves; /*!< number of pieces left to play until the end */
+        int score; /*!< number of pieces the winner has left when winning,
+                        negative if the active player loses, 0 for a draw */
+    };
+
+    /*!
+     * \brief Default memory budget of the transposition table, in megabytes
+     */
+    static const std::size_t DEFAULT_MEGABYTES = 64;
+
+private:
+    TranspositionTable _table;
+    bool _symmetry;
+    std::uint64_t _nodes;
+    std::uint64_t _probes;
+    std::uint64_t _hits;
+    unsigned _power;
+    unsigned _line;
+    unsigned _column;
+
+public:
+    /*!
+     * \brief Solver constructor
+     * \param megabytes the memory budget of the transposition table
+     */
+    Solver(std::size_t megabytes = DEFAULT_MEGABYTES);
+
+    /*!
+     * \brief Solve a position
+     * \param game a started, not finished game
+     * \return the result of the position
+     * \throw std::logic_error if the game is not started or is finished
+     */
+    Result solve(const ConnectN &game);
+
+    /*!
+     * \brief Return the number of positions visited by the last solve()
+     * \return the number of positions visited
+     */
+    std::uint64_t nodes() const;
+
+    /*!
+     * \brief Return the share of successful table lookups of the last
+     * solve()
+     * \return the number of results found over the number of lookups, 0 if
+     * nothing was looked up
+     */
+    double hitRate() const;
+
+    /*!
+     * \brief Check if a position and its mirror share their table entry
+     * \return `true` if the table is keyed by the canonical form of the
+     * positions
+     */
+    bool symmetry() const;
+
+    /*!
+     * \brief Make a position and its mirror share their table entry or not.
+     * The mirror of each position is then computed to find its key.
+     * \param symmetry `true` to key the table by the canonical form of the
+     * positions
+     */
+    void symmetry(bool symmetry);
+
+    /*!
+     * \brief Return the transposition table
+     * \return the transposition table
+     */
+    const TranspositionTable &table() const;
+};
+
+#endif // SOLVER_H
@@ -0,0 +1,79 @@
+#include <stdexcept>
+#include <utility>
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(unsigned threads) :
+    _threads(),
+    _tasks(),
+    _mutex(),
+    _available(),
+    _idle(),
+    _running(0),
+    _stopping(false)
+{
+    if (threads == 0) {
+        throw std::out_of_range("At least one thread is needed");
+    }
+    for (unsigned i = 0; i < threads; i++) {
+        _threads.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _available.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push(std::move(task));
+    }
+    _available.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this]() {
+        return _tasks.empty() && _running == 0;
+    });
+}
+
+unsigned ThreadPool::size() const
+{
+    return _threads.size();
+}
+
+void ThreadPool::work()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _available.wait(lock, [this]() {
+            return _stopping || !_tasks.empty();
+        });
+        if (_tasks.empty()) {
+            return;
+        }
+
+        std::function<void()> task = std::move(_tasks.front());
+        _tasks.pop();
+        _running++;
+        lock.unlock();
+        task();
+        lock.lock();
+        _running--;
+        if (_tasks.empty() && _running == 0) {
+            _idle.notify_all();
+        }
+    }
+}
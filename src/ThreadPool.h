@@ -0,0 +1,69 @@
+/*! \file ThreadPool.h
+ * ThreadPool class definition
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/*!
+ * \brief A fixed set of threads running queued tasks.
+ * Tasks are run in the order they were submitted, each by the first thread
+ * available. Tasks must not throw.
+ */
+class ThreadPool
+{
+private:
+    std::vector<std::thread> _threads;
+    std::queue<std::function<void()>> _tasks;
+    std::mutex _mutex;
+    std::condition_variable _available;
+    std::condition_variable _idle;
+    unsigned _running;
+    bool _stopping;
+
+    /* Run tasks until the pool is destroyed */
+    void work();
+
+public:
+    /*!
+     * \brief ThreadPool constructor
+     * \param threads the number of threads
+     * \throw std::out_of_range if threads is 0
+     */
+    ThreadPool(unsigned threads);
+
+    /*!
+     * \brief ThreadPool destructor. Queued tasks are run before the threads
+     * are joined.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /*!
+     * \brief Queue a task
+     * \param task the task to run
+     */
+    void submit(std::function<void()> task);
+
+    /*!
+     * \brief Wait until all the queued tasks are done
+     */
+    void wait();
+
+    /*!
+     * \brief Return the number of threads
+     * \return the number of threads
+     */
+    unsigned size() const;
+};
+
+#endif // THREADPOOL_H
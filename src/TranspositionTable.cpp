@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "TranspositionTable.h"
+
+/* Packed entry: score on bits 0-31, depth on bits 32-39, bound on bits 40-41
+ * and move on bits 42-47. A stored entry always has a bound, so an empty slot
+ * is the only one with a null data word.
+ */
+
+static std::uint64_t pack(const TranspositionTable::Entry &entry)
+{
+    return std::uint64_t(std::uint32_t(entry.score))
+            | std::uint64_t(std::min(entry.depth, 255u)) << 32
+            | std::uint64_t(entry.bound) << 40
+            | std::uint64_t(entry.move & 0x3f) << 42;
+}
+
+static TranspositionTable::Entry unpack(std::uint64_t data)
+{
+    return TranspositionTable::Entry{
+        int(std::uint32_t(data)),
+        unsigned(data >> 32) & 0xff,
+        TranspositionTable::Bound((data >> 40) & 0x3),
+        unsigned(data >> 42) & 0x3f
+    };
+}
+
+TranspositionTable::TranspositionTable(std::size_t megabytes) :
+    _slots(),
+    _size(1)
+{
+    std::size_t capacity = (megabytes << 20) / sizeof(Slot);
+    if (capacity == 0) {
+        throw std::invalid_argument("Transposition table is too small");
+    }
+    while (_size * 2 <= capacity) {
+        _size *= 2;
+    }
+    _slots.reset(new Slot[_size]);
+    clear();
+}
+
+bool TranspositionTable::probe(std::uint64_t hash, Entry &entry) const
+{
+    const Slot &slot = _slots[hash & (_size - 1)];
+    std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+
+    if (data == 0 || (check ^ data) != hash) {
+        return false;
+    }
+    entry = unpack(data);
+
+    return true;
+}
+
+void TranspositionTable::store(std::uint64_t hash, const Entry &entry)
+{
+    Slot &slot = _slots[hash & (_size - 1)];
+    std::uint64_t data = pack(entry);
+
+    slot.check.store(hash ^ data, std::memory_order_relaxed);
+    slot.data.store(data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (std::size_t i = 0; i < _size; i++) {
+        _slots[i].check.store(0, std::memory_order_relaxed);
+        _slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::size_t TranspositionTable::size() const
+{
+    return _size;
+}
+
+double TranspositionTable::fill() const
+{
+    /* hashes are uniform: the start of the table is a fair sample */
+    std::size_t sample = std::min(_size, std::size_t(1) << 16);
+    std::size_t used = 0;
+
+    for (std::size_t i = 0; i < sample; i++) {
+        if (_slots[i].data.load(std::memory_order_relaxed) != 0) {
+            used++;
+        }
+    }
+
+    return double(used) / sample;
+}
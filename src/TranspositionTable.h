@@ -0,0 +1,104 @@
+/*! \file TranspositionTable.h
+ * TranspositionTable class definition
+ */
+
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/*!
+ * \brief A fixed-size table of search results, indexed by position hash.
+ * Each entry is made of two 64-bit words: the packed result and the hash
+ * XORed with that result. Both words are read and written without locks; a
+ * reader only accepts an entry if the XOR of the two words gives back its
+ * hash, so an entry torn by concurrent writers is seen as a miss. Several
+ * search threads can therefore share a single table. Lookups write nothing
+ * to the table: the searches count their own probes and hits.
+ */
+class TranspositionTable
+{
+public:
+    /*!
+     * \brief The kind of score stored in an entry
+     */
+    enum class Bound : unsigned char {
+        NONE, /*!< no score */
+        UPPER, /*!< the score is at most the stored one */
+        LOWER, /*!< the score is at least the stored one */
+        EXACT /*!< the score is the stored one */
+    };
+
+    /*!
+     * \brief A search result
+     */
+    struct Entry
+    {
+        int score; /*!< the score of the position */
+        unsigned depth; /*!< the depth the position was searched to */
+        Bound bound; /*!< the kind of score */
+        unsigned move; /*!< the best column found */
+    };
+
+    /*!
+     * \brief Default memory budget, in megabytes
+     */
+    static const std::size_t DEFAULT_MEGABYTES = 16;
+
+private:
+    struct Slot
+    {
+        std::atomic<std::uint64_t> check;
+        std::atomic<std::uint64_t> data;
+    };
+
+    std::unique_ptr<Slot[]> _slots;
+    std::size_t _size;
+
+public:
+    /*!
+     * \brief TranspositionTable constructor. The table is empty.
+     * \param megabytes the memory budget of the table; the number of entries
+     * is the largest power of two fitting in it
+     * \throw std::invalid_argument if the budget cannot hold one entry
+     */
+    TranspositionTable(std::size_t megabytes = DEFAULT_MEGABYTES);
+
+    /*!
+     * \brief Look for the result of a position
+     * \param hash the hash of the position
+     * \param entry filled with the stored result if found
+     * \return `true` if a result was found, `false` otherwise
+     */
+    bool probe(std::uint64_t hash, Entry &entry) const;
+
+    /*!
+     * \brief Store the result of a position, replacing the previous one in
+     * its slot
+     * \param hash the hash of the position
+     * \param entry the result
+     */
+    void store(std::uint64_t hash, const Entry &entry);
+
+    /*!
+     * \brief Empty the table
+     */
+    void clear();
+
+    /*!
+     * \brief Return the number of entries
+     * \return the number of entries
+     */
+    std::size_t size() const;
+
+    /*!
+     * \brief Return the share of used entries, estimated on a sample
+     * \return the share of used entries, between 0 and 1
+     */
+    double fill() const;
+};
+
+#endif // TRANSPOSITIONTABLE_H
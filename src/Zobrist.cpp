@@ -0,0 +1,22 @@
+#include "Zobrist.h"
+
+const std::array<std::array<std::uint64_t, BitPlane::BITS>, 2>
+Zobrist::_keys = Zobrist::generate();
+
+std::array<std::array<std::uint64_t, BitPlane::BITS>, 2> Zobrist::generate()
+{
+    std::array<std::array<std::uint64_t, BitPlane::BITS>, 2> keys;
+    /* splitmix64: fixed keys give the same hashes from run to run */
+    std::uint64_t state = 0x436f6e6e6563744eULL;
+
+    for (auto &side : keys) {
+        for (auto &key : side) {
+            std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            key = z ^ (z >> 31);
+        }
+    }
+
+    return keys;
+}
@@ -0,0 +1,45 @@
+/*! \file Zobrist.h
+ * Zobrist class definition
+ */
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <array>
+#include <cstdint>
+
+#include "BitPlane.h"
+
+/*!
+ * \brief Zobrist keys of the pieces of a board.
+ * The hash of a position is the XOR of the keys of its pieces. A piece is
+ * keyed by its bit in the BitBoard planes and by the player who dropped it:
+ * the player who moved first (side 0) or the other one (side 1). The hash
+ * thus does not depend on the colors drawn by the players, and the side to
+ * move is given by the number of pieces.
+ */
+class Zobrist
+{
+private:
+    static const std::array<std::array<std::uint64_t, BitPlane::BITS>, 2> _keys;
+
+    /* Generate the keys from a fixed seed */
+    static std::array<std::array<std::uint64_t, BitPlane::BITS>, 2> generate();
+
+public:
+    /*!
+     * \brief Return the key of a piece
+     * \param side 0 if the piece was dropped by the player who moved first,
+     * 1 otherwise
+     * \param bit the bit index of the piece in the BitBoard planes
+     * \return the key of the piece
+     */
+    static std::uint64_t key(unsigned side, unsigned bit);
+};
+
+inline std::uint64_t Zobrist::key(unsigned side, unsigned bit)
+{
+    return _keys[side][bit];
+}
+
+#endif // ZOBRIST_H
@@ -0,0 +1,72 @@
+# Game and engine sources, shared by the game and the tools
+
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/Alignments.cpp \
+    $$PWD/Arena.cpp \
+    $$PWD/BitBoard.cpp \
+    $$PWD/BoardView.cpp \
+    $$PWD/Color.cpp \
+    $$PWD/ComputerPlayer.cpp \
+    $$PWD/ConnectN.cpp \
+    $$PWD/Engine.cpp \
+    $$PWD/EngineProtocol.cpp \
+    $$PWD/GameRecord.cpp \
+    $$PWD/GameServer.cpp \
+    $$PWD/GreedyEngine.cpp \
+    $$PWD/Mcts.cpp \
+    $$PWD/MoveOrder.cpp \
+    $$PWD/Negamax.cpp \
+    $$PWD/OpeningBook.cpp \
+    $$PWD/Player.cpp \
+    $$PWD/Position.cpp \
+    $$PWD/Random.cpp \
+    $$PWD/RandomEngine.cpp \
+    $$PWD/RecordReader.cpp \
+    $$PWD/RecordWriter.cpp \
+    $$PWD/SelfPlay.cpp \
+    $$PWD/Solver.cpp \
+    $$PWD/ThreadPool.cpp \
+    $$PWD/TranspositionTable.cpp \
+    $$PWD/Zobrist.cpp
+
+HEADERS += \
+    $$PWD/libs/keyboard.hpp \
+    $$PWD/libs/stringConvert.hpp \
+    $$PWD/Alignments.h \
+    $$PWD/Arena.h \
+    $$PWD/BitBoard.h \
+    $$PWD/BitPlane.h \
+    $$PWD/BoardFactory.h \
+    $$PWD/BoardView.h \
+    $$PWD/Color.h \
+    $$PWD/ComputerPlayer.h \
+    $$PWD/ConnectN.h \
+    $$PWD/Engine.h \
+    $$PWD/EngineProtocol.h \
+    $$PWD/FixedBoard.h \
+    $$PWD/GameRecord.h \
+    $$PWD/GameServer.h \
+    $$PWD/GenericBoard.h \
+    $$PWD/GreedyEngine.h \
+    $$PWD/Mcts.h \
+    $$PWD/MoveOrder.h \
+    $$PWD/NodePool.h \
+    $$PWD/Negamax.h \
+    $$PWD/OpeningBook.h \
+    $$PWD/Player.h \
+    $$PWD/Position.h \
+    $$PWD/Random.h \
+    $$PWD/RandomEngine.h \
+    $$PWD/RecordReader.h \
+    $$PWD/RecordWriter.h \
+    $$PWD/SelfPlay.h \
+    $$PWD/Solver.h \
+    $$PWD/ThreadPool.h \
+    $$PWD/TranspositionTable.h \
+    $$PWD/Zobrist.h
+
+# Searches may run on several threads
+QMAKE_CXXFLAGS += -pthread
+LIBS += -pthread
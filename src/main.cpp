@@ -1,7 +1,14 @@
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include "BoardView.h"
 #include "ConnectN.h"
 #include "Player.h"
+#include "ComputerPlayer.h"
+#include "Negamax.h"
+#include "RecordReader.h"
 #include "libs/keyboard.hpp"
 
 using namespace std;
@@ -21,20 +28,177 @@ void printLogo()
     cout << endl;
 }
 
+/*!
+ * \brief Ask for the name and the kind of the player of the given seat
+ * \param seat the seat number, 1 or 2
+ * \param threads number of search threads of a computer player
+ * \param book opening book of a computer player, if any
+ * \return a human or computer player
+ */
+unique_ptr<Player> createPlayer(unsigned seat, unsigned threads,
+                                shared_ptr<const OpeningBook> book)
+{
+    string name;
+    char computer;
+    unsigned depth = 0;
+    unsigned budget = 0;
+    unsigned megabytes = 0;
+    shared_ptr<TranspositionTable> table;
+
+    /* Player name */
+    do {
+        try {
+            cout << "Name of player " << seat << " : ";
+            name = nvs::lineFromKbd<string>();
+        } catch (const nvs::bad_string_convert &e) {
+            cout << "Please enter a name" << endl;
+        }
+    } while (name.empty());
+
+    try {
+        cout << "Is " << name << " played by the computer? (y/[N]) ";
+        computer = nvs::lineFromKbd<char>();
+    } catch (const nvs::bad_string_convert &) {
+        computer = 'N';
+    }
+
+    if (computer != 'y' && computer != 'Y') {
+        return unique_ptr<Player>(new Player(name));
+    }
+
+    /* Search depth */
+    do {
+        cout << "Maximum search depth? (1-"
+             << ConnectN::DELTA_LINE * ConnectN::DELTA_COLUMN << ") ["
+             << Negamax::DEFAULT_DEPTH << "] ";
+        try {
+            depth = nvs::lineFromKbd<unsigned>();
+        } catch (const nvs::bad_string_convert &) {
+            depth = Negamax::DEFAULT_DEPTH;
+        }
+    } while (depth < 1 || depth > ConnectN::DELTA_LINE * ConnectN::DELTA_COLUMN);
+
+    /* Time budget */
+    cout << "Time per move in ms? (0 for no limit) [0] ";
+    try {
+        budget = nvs::lineFromKbd<unsigned>();
+    } catch (const nvs::bad_string_convert &) {
+        budget = 0;
+    }
+
+    /* Transposition table size */
+    do {
+        cout << "Hash table size in MB? (0-4096) ["
+             << TranspositionTable::DEFAULT_MEGABYTES << "] ";
+        try {
+            megabytes = nvs::lineFromKbd<unsigned>();
+        } catch (const nvs::bad_string_convert &) {
+            megabytes = TranspositionTable::DEFAULT_MEGABYTES;
+        }
+    } while (megabytes > 4096);
+    if (megabytes > 0) {
+        table = make_shared<TranspositionTable>(megabytes);
+    }
+
+    unique_ptr<Negamax> search(new Negamax(depth, table, threads));
+    search->budget(budget);
+    search->book(book);
+
+    return unique_ptr<Player>(new ComputerPlayer(name, move(search)));
+}
+
+/*!
+ * \brief Print every position of recorded games, as a log
+ * \param path the path of a record stream written by RecordWriter
+ * \throw std::runtime_error if the file is not a valid record stream
+ * \throw std::invalid_argument if a record is not a valid game
+ */
+void spectate(const string &path)
+{
+    Player first { "first" };
+    Player second { "second" };
+    ifstream file(path, ios::binary);
+    RecordReader reader(file);
+    GameRecord record;
+    unique_ptr<BoardView> view;
+
+    while (reader.next(record)) {
+        ConnectN game(record.power, record.line, record.column, 0);
+        game.enroll(&first, &second, record.color, record.active);
+        if (view == nullptr || game.line() != view->line()
+                || game.column() != view->column()) {
+            view.reset(new BoardView(game.line(), game.column()));
+        }
+
+        cout << "Game " << reader.records() << ", Connect" << game.power()
+             << ", " << record.moves.size() << " moves\n";
+        for (unsigned char column : record.moves) {
+            Color color = game.color(game.activePlayer());
+            game.play(column);
+            cout << game.movesPlayed() << ". " << color << " " << unsigned(column)
+                 << "\n" << view->render(game);
+        }
+        if (game.winner() != nullptr) {
+            cout << "Winner: " << game.color(game.winner()) << "\n\n";
+        } else {
+            cout << (game.finished() ? "No winner!" : "Unfinished") << "\n\n";
+        }
+    }
+    cout.flush();
+}
+
 /*!
  * \brief Main program
+ * \param argc number of arguments
+ * \param argv arguments: `--threads N` sets the number of search threads of
+ * the computer players, `--book FILE` their opening book, `--spectate FILE`
+ * prints the games recorded in FILE instead of playing
  * \return 0 if everything went fine
  */
-int main()
+int main(int argc, char *argv[])
 {
     ConnectN game;
+    unsigned threads = 1;
+    shared_ptr<const OpeningBook> book;
     unsigned power;
     unsigned line;
     unsigned column;
     unsigned columnIn;
     char customGame;
-    string namePlayer1;
-    string namePlayer2;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--threads" && i + 1 < argc) {
+            try {
+                threads = nvs::fromString<unsigned>(argv[++i]);
+            } catch (const nvs::bad_string_convert &) {
+                threads = 0;
+            }
+            if (threads == 0) {
+                cerr << "--threads needs a positive number" << endl;
+                return 1;
+            }
+        } else if (arg == "--book" && i + 1 < argc) {
+            try {
+                book = make_shared<const OpeningBook>(argv[++i]);
+            } catch (const std::runtime_error &e) {
+                cerr << e.what() << endl;
+                return 1;
+            }
+        } else if (arg == "--spectate" && i + 1 < argc) {
+            try {
+                spectate(argv[++i]);
+            } catch (const std::exception &e) {
+                cerr << e.what() << endl;
+                return 1;
+            }
+            return 0;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--threads N] [--book FILE]"
+                 << " [--spectate FILE]" << endl;
+            return 1;
+        }
+    }
 
     printLogo();
 
@@ -83,42 +247,55 @@ int main()
         //game = ConnectN();
     }
 
-    /* Player1 name */
-    do {
-        try {
-            cout << "Name of player 1 : ";
-            namePlayer1 = nvs::lineFromKbd<string>();
-        } catch (const nvs::bad_string_convert &e) {
-            cout << "Please enter a name" << endl;
-        }
-    } while (namePlayer1.empty());
-
-    /* Player2 name */
-    do {
-        try {
-            cout << "Name of player 2 : ";
-            namePlayer2 = nvs::lineFromKbd<string>();
-        } catch (const nvs::bad_string_convert &e) {
-            cout << "Please enter a name" << endl;
-        }
-    } while (namePlayer2.empty());
-
-    Player player1 { namePlayer1.c_str() };
-    Player player2 { namePlayer2.c_str() };
+    unique_ptr<Player> player1 = createPlayer(1, threads, book);
+    unique_ptr<Player> player2 = createPlayer(2, threads, book);
 
     /* Enroll the two players */
-    game.enroll(&player1);
-    game.enroll(&player2);
+    game.enroll(player1.get());
+    game.enroll(player2.get());
+
+    /* Only the cell of the last move is redrawn from turn to turn */
+    BoardView view(game.line(), game.column());
 
     /* Game is started */
     while (!(game.finished())) {
         try {
             cout << endl;
             cout << "You are playing a Connect" << game.power() << endl << endl;
-            cout << game << endl;
+            cout << view.render(game) << endl;
             cout << game.activePlayer()->name() << "'s turn";
             cout << " (" << game.color(game.activePlayer()) << "): ";
-            columnIn = nvs::lineFromKbd<unsigned>();
+            const ComputerPlayer *computer =
+                    dynamic_cast<const ComputerPlayer *>(game.activePlayer());
+            if (computer != nullptr) {
+                columnIn = computer->play(game);
+                cout << columnIn << endl;
+                const Negamax *search =
+                        dynamic_cast<const Negamax *>(&computer->engine());
+                if (search != nullptr && search->stats().book) {
+                    cout << "book move" << endl;
+                } else if (search != nullptr) {
+                    cout << search->stats().nodes << " nodes in "
+                         << search->stats().seconds << " s ("
+                         << static_cast<unsigned long>(
+                                search->stats().nodesPerSecond())
+                         << " nodes/s)" << endl;
+                    cout << "depth " << search->stats().depth << ":";
+                    for (double seconds : search->stats().iterations) {
+                        cout << " " << seconds;
+                    }
+                    cout << " s" << endl;
+                    if (search->table() != nullptr) {
+                        cout << "hash hits: "
+                             << search->stats().hitRate() * 100
+                             << "%, hash full: "
+                             << search->table()->fill() * 100 << "%"
+                             << endl;
+                    }
+                }
+            } else {
+                columnIn = nvs::lineFromKbd<unsigned>();
+            }
             try {
                 game.play(columnIn);
             } catch (const std::out_of_range &e) {
@@ -132,7 +309,7 @@ int main()
     }
 
     cout << endl;
-    cout << game << endl;
+    cout << view.render(game) << endl;
 
     if (game.winner() != nullptr) {
         cout << "Winner: " << game.winner()->name();
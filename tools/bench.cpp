@@ -0,0 +1,1378 @@
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "Alignments.h"
+#include "Arena.h"
+#include "BitBoard.h"
+#include "BoardFactory.h"
+#include "BoardView.h"
+#include "ConnectN.h"
+#include "Mcts.h"
+#include "MoveOrder.h"
+#include "Negamax.h"
+#include "Player.h"
+#include "Position.h"
+#include "Random.h"
+#include "RecordReader.h"
+#include "RecordWriter.h"
+#include "Solver.h"
+#include "TranspositionTable.h"
+#include "Zobrist.h"
+#include "libs/stringConvert.hpp"
+
+using namespace std;
+
+/*!
+ * \brief Calls to the global allocator, counted by the replacement of
+ * operator new below
+ */
+static atomic<uint64_t> heapAllocations(0);
+
+/*!
+ * \brief Global allocation function, counting its calls. Neither it nor
+ * operator delete is inlined, so that the compiler does not pair malloc()
+ * and free() with the new and delete expressions of the program.
+ * \param size the number of bytes
+ * \return the memory
+ * \throw std::bad_alloc if the memory cannot be allocated
+ */
+__attribute__((noinline)) void *operator new(size_t size)
+{
+    heapAllocations++;
+    void *memory = malloc(size > 0 ? size : 1);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+/*!
+ * \brief Global deallocation function, matching operator new
+ * \param memory memory from operator new
+ */
+__attribute__((noinline)) void operator delete(void *memory) noexcept
+{
+    free(memory);
+}
+
+/*!
+ * \brief Read an optional unsigned argument
+ * \param argc number of arguments
+ * \param argv arguments
+ * \param index index of the argument
+ * \param value default value
+ * \return the argument at the given index, the default value if absent
+ */
+unsigned argument(int argc, char *argv[], int index, unsigned value)
+{
+    return index < argc ? nvs::fromString<unsigned>(argv[index]) : value;
+}
+
+/*!
+ * \brief Lazy SMP benchmark.
+ * Search the empty default board to a fixed depth with 1, 2, 4... threads
+ * and report the speedup of each thread count over a single thread.
+ * \param depth the search depth
+ * \param maxThreads the largest thread count
+ */
+void benchSmp(unsigned depth, unsigned maxThreads)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    ConnectN game;
+    double single = 0;
+
+    game.enroll(&player1);
+    game.enroll(&player2);
+
+    cout << "Lazy SMP, default board, depth " << depth << endl;
+    cout << setw(8) << "threads" << setw(12) << "seconds" << setw(14) << "nodes"
+         << setw(14) << "nodes/s" << setw(10) << "speedup" << setw(8) << "move"
+         << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        auto table = make_shared<TranspositionTable>(64);
+        Negamax search(depth, table, threads);
+        unsigned move = search.bestMove(game);
+        const SearchStats &stats = search.stats();
+        if (threads == 1) {
+            single = stats.seconds;
+        }
+        cout << setw(8) << threads << setw(12) << fixed << setprecision(3)
+             << stats.seconds << setw(14) << stats.nodes << setw(14)
+             << setprecision(0) << stats.nodesPerSecond() << setw(10)
+             << setprecision(2) << single / stats.seconds << setw(8) << move
+             << endl;
+    }
+}
+
+/*!
+ * \brief Monte Carlo tree search benchmark.
+ * Choose the first move of the given board with 1, 2, 4... threads and
+ * report the playouts per second of each thread count.
+ * \param playouts the number of playouts
+ * \param maxThreads the largest thread count
+ * \param power the number of pieces to align
+ * \param lines the number of lines of the board
+ * \param columns the number of columns of the board
+ */
+void benchMcts(unsigned playouts, unsigned maxThreads, unsigned power,
+               unsigned lines, unsigned columns)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    ConnectN game(power, lines, columns);
+    double single = 0;
+
+    game.enroll(&player1);
+    game.enroll(&player2);
+
+    /* the colors are dealt at random: the engine must find a win in one
+     * whichever color moved first */
+    for (Color first : {Color::BLACK, Color::WHITE}) {
+        ConnectN threat;
+        threat.enroll(&player1, &player2, first, 0);
+        for (unsigned column : {0, 6, 0, 6, 0, 6}) {
+            threat.play(column);
+        }
+        if (Mcts(playouts).bestMove(threat) != 0) {
+            throw logic_error("MCTS misses a win when " + to_string(first)
+                              + " moves first");
+        }
+    }
+
+    cout << "MCTS, power " << power << ", " << lines << "x" << columns
+         << " board, " << playouts << " playouts" << endl;
+    cout << setw(8) << "threads" << setw(12) << "seconds" << setw(14)
+         << "playouts/s" << setw(10) << "speedup" << setw(10) << "nodes"
+         << setw(8) << "move" << endl;
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        Mcts search(playouts, threads);
+        unsigned move = search.bestMove(game);
+        const MctsStats &stats = search.stats();
+        if (threads == 1) {
+            single = stats.playoutsPerSecond();
+        }
+        cout << setw(8) << threads << setw(12) << fixed << setprecision(3)
+             << stats.seconds << setw(14) << setprecision(0)
+             << stats.playoutsPerSecond() << setw(10) << setprecision(2)
+             << stats.playoutsPerSecond() / single << setw(10) << stats.nodes
+             << setw(8) << move << endl;
+    }
+}
+
+/*!
+ * \brief Count the leaves of the game tree
+ * \param game the game to walk, restored on return
+ * \param depth the number of moves to play
+ * \return the number of games reached after depth moves, or finished before
+ */
+uint64_t perft(ConnectN &game, unsigned depth)
+{
+    if (depth == 0 || game.finished()) {
+        return 1;
+    }
+
+    uint64_t leaves = 0;
+    for (unsigned column = 0; column < game.column(); column++) {
+        if (game.tryPlay(column) == ConnectN::MoveStatus::PLAYED) {
+            leaves += perft(game, depth - 1);
+            game.undo();
+        }
+    }
+    return leaves;
+}
+
+/*!
+ * \brief Count the leaves of the game tree on a bare BitBoard.
+ * Each move does what ConnectN::play() does to the board: drop the piece,
+ * update the hash and look for an alignment around it. The drops and the
+ * alignment checks can be repeated, so that the time of one more of them is
+ * measured on the very same tree.
+ * \param board the board to walk, restored on return
+ * \param power the number of pieces to align
+ * \param depth the number of moves to play
+ * \param moves the number of pieces on the board
+ * \param drops the number of times each piece is dropped
+ * \param checks the number of times each alignment check is done
+ * \param hash the hash of the board
+ * \return the number of leaves
+ */
+uint64_t perftBoard(BitBoard &board, unsigned power, unsigned depth,
+                    unsigned moves, unsigned drops, unsigned checks,
+                    uint64_t &hash)
+{
+    static const int directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+
+    if (depth == 0) {
+        return 1;
+    }
+
+    Color color = moves % 2 ? Color::WHITE : Color::BLACK;
+    uint64_t leaves = 0;
+    for (unsigned column = 0; column < board.column(); column++) {
+        if (!board.playable(column)) {
+            continue;
+        }
+        unsigned line = 0;
+        for (unsigned i = 0; i < drops; i++) {
+            if (i > 0) {
+                __asm__ __volatile__("" ::: "memory");
+                board.remove(column);
+                hash ^= Zobrist::key(moves % 2, board.bit(line, column));
+            }
+            line = board.drop(column, color);
+            hash ^= Zobrist::key(moves % 2, board.bit(line, column));
+        }
+
+        bool aligned = false;
+        for (unsigned i = 0; i < checks; i++) {
+            /* keep the compiler from merging the repeated checks */
+            __asm__ __volatile__("" ::: "memory");
+            aligned = false;
+            for (const auto &direction : directions) {
+                unsigned count = 1 + board.run(line, column, direction[0],
+                                               direction[1], color, power - 1);
+                /* the last dropped piece is the top of its column */
+                if (direction[0] != 1 || direction[1] != 0) {
+                    count += board.run(line, column, -direction[0],
+                                       -direction[1], color, power - 1);
+                }
+                aligned = aligned || count >= power;
+            }
+        }
+
+        if (aligned || moves + 1 == board.line() * board.column()) {
+            leaves++;
+        } else {
+            leaves += perftBoard(board, power, depth - 1, moves + 1, drops,
+                                 checks, hash);
+        }
+        board.remove(column);
+        hash ^= Zobrist::key(moves % 2, board.bit(line, column));
+    }
+    return leaves;
+}
+
+/*!
+ * \brief Move generation benchmark.
+ * Count the leaves of the game tree at each depth up to the given one, then
+ * split the time of a move at the last depth between the piece drop, the
+ * alignment checks and the rest of ConnectN::play() and undo(). The shares
+ * are measured by walking the same tree on a bare BitBoard, once as is and
+ * once with each drop or each check repeated.
+ * \param power the number of pieces to align
+ * \param lines the number of lines of the board
+ * \param columns the number of columns of the board
+ * \param depth the largest depth
+ * \param moves the columns played to reach the position to walk from
+ */
+void benchPerft(unsigned power, unsigned lines, unsigned columns,
+                unsigned depth, const vector<unsigned> &moves)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    ConnectN game(power, lines, columns);
+    uint64_t leaves = 0;
+    double seconds = 0;
+
+    game.enroll(&player1);
+    game.enroll(&player2);
+    for (unsigned column : moves) {
+        game.play(column);
+    }
+    if (game.finished()) {
+        throw logic_error("Game already finished");
+    }
+
+    cout << "Perft, power " << power << ", " << lines << "x" << columns
+         << " board, " << moves.size() << " moves played" << endl;
+    cout << setw(6) << "depth" << setw(16) << "leaves" << setw(12) << "seconds"
+         << setw(14) << "leaves/s" << endl;
+    for (unsigned d = 1; d <= depth; d++) {
+        auto start = chrono::steady_clock::now();
+        leaves = perft(game, d);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        seconds = elapsed.count();
+        cout << setw(6) << d << setw(16) << leaves << setw(12) << fixed
+             << setprecision(3) << seconds << setw(14) << setprecision(0)
+             << leaves / seconds << endl;
+    }
+
+    /* best seconds of a few bare walks with the given repetitions */
+    auto walk = [&](unsigned drops, unsigned checks) {
+        double best = 0;
+        for (unsigned run = 0; run < 3; run++) {
+            BitBoard board(lines, columns);
+            uint64_t hash = 0;
+            for (unsigned i = 0; i < moves.size(); i++) {
+                board.drop(moves[i], i % 2 ? Color::WHITE : Color::BLACK);
+            }
+            auto start = chrono::steady_clock::now();
+            uint64_t count = perftBoard(board, power, depth, moves.size(),
+                                        drops, checks, hash);
+            chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+            if (count != leaves) {
+                throw logic_error("Perft mismatch between ConnectN and BitBoard");
+            }
+            if (run == 0 || elapsed.count() < best) {
+                best = elapsed.count();
+            }
+        }
+        return best;
+    };
+    /* the extra drops and checks are repeated to stand out of the noise */
+    const unsigned repeat = 4;
+    double bare = walk(1, 1);
+    double drop = max(walk(1 + repeat, 1) - bare, 0.0) / repeat;
+    double checks = max(walk(1, 1 + repeat) - bare, 0.0) / repeat;
+    double other = max(seconds - drop - checks, 0.0);
+
+    cout << "Time of ConnectN::play() and undo() at depth " << depth << ":"
+         << endl;
+    cout << "  drop and removal   " << setw(8) << setprecision(1)
+         << 100 * drop / seconds << " %" << endl;
+    cout << "  alignment checks   " << setw(8) << 100 * checks / seconds << " %"
+         << endl;
+    cout << "  rest of the walk   " << setw(8) << 100 * other / seconds << " %"
+         << endl;
+}
+
+/*!
+ * \brief Count the leaves of the game tree on a FixedBoard or GenericBoard
+ * \param board the board to walk, restored on return
+ * \param depth the number of moves to play
+ * \return the number of leaves
+ */
+template<typename Board>
+uint64_t perftTemplate(Board &board, unsigned depth)
+{
+    if (depth == 0) {
+        return 1;
+    }
+
+    uint64_t leaves = 0;
+    for (unsigned column = 0; column < board.column(); column++) {
+        if (board.playable(column)) {
+            if (board.play(column) || board.full()) {
+                leaves++;
+            } else {
+                leaves += perftTemplate(board, depth - 1);
+            }
+            board.undo();
+        }
+    }
+    return leaves;
+}
+
+/*!
+ * \brief Timed perft, called by dispatchBoard()
+ */
+struct PerftWalk
+{
+    unsigned depth; /*!< the number of moves to play */
+    uint64_t leaves; /*!< the number of leaves found */
+    double seconds; /*!< the time of the walk */
+
+    /*!
+     * \brief Walk the game tree
+     * \param board the board to walk from
+     */
+    template<typename Board>
+    void operator()(Board &board)
+    {
+        auto start = chrono::steady_clock::now();
+        leaves = perftTemplate(board, depth);
+        seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                           - start).count();
+    }
+};
+
+/*!
+ * \brief Fixed board benchmark.
+ * Count the leaves of the game tree on a ConnectN, on a GenericBoard and on
+ * the board dispatchBoard() picks, and report the speedup of each over
+ * ConnectN.
+ * \param power the number of pieces to align
+ * \param lines the number of lines of the board
+ * \param columns the number of columns of the board
+ * \param depth the number of moves to play
+ */
+void benchFixed(unsigned power, unsigned lines, unsigned columns,
+                unsigned depth)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    ConnectN game(power, lines, columns);
+    PerftWalk generic{depth, 0, 0};
+    PerftWalk dispatched{depth, 0, 0};
+
+    game.enroll(&player1);
+    game.enroll(&player2);
+    auto start = chrono::steady_clock::now();
+    uint64_t leaves = perft(game, depth);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                              - start).count();
+    GenericBoard board(power, lines, columns);
+    generic(board);
+    bool specialized = dispatchBoard(power, lines, columns, dispatched);
+    if (generic.leaves != leaves || dispatched.leaves != leaves) {
+        throw logic_error("Perft mismatch between the boards");
+    }
+
+    cout << "Perft, power " << power << ", " << lines << "x" << columns
+         << " board, depth " << depth << ", " << leaves << " leaves" << endl;
+    cout << setw(14) << "board" << setw(12) << "seconds" << setw(14)
+         << "leaves/s" << setw(10) << "speedup" << endl;
+    cout << setw(14) << "ConnectN" << setw(12) << fixed << setprecision(3)
+         << seconds << setw(14) << setprecision(0) << leaves / seconds
+         << setw(10) << setprecision(2) << 1.0 << endl;
+    cout << setw(14) << "GenericBoard" << setw(12) << setprecision(3)
+         << generic.seconds << setw(14) << setprecision(0)
+         << leaves / generic.seconds << setw(10) << setprecision(2)
+         << seconds / generic.seconds << endl;
+    if (specialized) {
+        cout << setw(14) << "FixedBoard" << setw(12) << setprecision(3)
+             << dispatched.seconds << setw(14) << setprecision(0)
+             << leaves / dispatched.seconds << setw(10) << setprecision(2)
+             << seconds / dispatched.seconds << endl;
+    } else {
+        cout << "No FixedBoard for this size" << endl;
+    }
+}
+
+/*!
+ * \brief Threat detection benchmark.
+ * Find the threats of both colors on random positions, once by checking each
+ * empty cell with BitBoard::aligned() and once with each whole-board kernel
+ * of Alignments, on 64-bit words and on AVX2 when the processor has it, and
+ * report the positions per second of each. The threats and the alignments
+ * found by the kernels are checked bit by bit against the cell scan.
+ * \param power the number of pieces to align
+ * \param lines the number of lines of the board
+ * \param columns the number of columns of the board
+ * \param positions the number of random positions
+ */
+void benchThreats(unsigned power, unsigned lines, unsigned columns,
+                  unsigned positions)
+{
+    const array<Color, 2> colors{{Color::BLACK, Color::WHITE}};
+    Random random(positions);
+    vector<BitBoard> boards;
+    uint64_t cellThreats = 0;
+
+    /* check the power before timing anything */
+    Alignments::threats(BitBoard(lines, columns), Color::BLACK, power);
+    for (unsigned i = 0; i < positions; i++) {
+        BitBoard board(lines, columns);
+        unsigned pieces = random.below(lines * columns + 1);
+        for (unsigned j = 0; j < pieces; j++) {
+            unsigned column;
+            do {
+                column = random.below(columns);
+            } while (!board.playable(column));
+            board.drop(column, j % 2 ? Color::WHITE : Color::BLACK);
+        }
+        boards.push_back(board);
+    }
+
+    /* the threats of each board and color, cell by cell */
+    vector<BitPlane> expected(2 * positions);
+    auto start = chrono::steady_clock::now();
+    for (unsigned i = 0; i < positions; i++) {
+        const BitBoard &board = boards[i];
+        for (unsigned column = 0; column < columns; column++) {
+            for (unsigned line = 0; line < lines; line++) {
+                if (board.cell(line, column) != Color::NONE) {
+                    continue;
+                }
+                for (unsigned c = 0; c < 2; c++) {
+                    if (board.aligned(line, column, colors[c], power)) {
+                        expected[2 * i + c].set(board.bit(line, column));
+                        cellThreats++;
+                    }
+                }
+            }
+        }
+    }
+    double cellSeconds = chrono::duration<double>(chrono::steady_clock::now()
+                                                  - start).count();
+
+    /* the alignments of each board and color, cell by cell */
+    vector<bool> alignments(2 * positions, false);
+    for (unsigned i = 0; i < positions; i++) {
+        const BitBoard &board = boards[i];
+        for (unsigned column = 0; column < columns; column++) {
+            for (unsigned line = 0; line < lines; line++) {
+                for (unsigned c = 0; c < 2; c++) {
+                    if (board.cell(line, column) == colors[c]
+                            && board.aligned(line, column, colors[c], power)) {
+                        alignments[2 * i + c] = true;
+                    }
+                }
+            }
+        }
+    }
+
+    cout << "Threats, power " << power << ", " << lines << "x" << columns
+         << " board, " << positions << " positions, " << cellThreats
+         << " threats" << endl;
+    cout << setw(14) << "method" << setw(12) << "seconds" << setw(14)
+         << "positions/s" << setw(10) << "speedup" << endl;
+    cout << setw(14) << "cell scan" << setw(12) << fixed << setprecision(3)
+         << cellSeconds << setw(14) << setprecision(0)
+         << positions / cellSeconds << setw(10) << setprecision(2) << 1.0
+         << endl;
+
+    /* the words first, then AVX2 when the processor has it */
+    bool avx2 = Alignments::vectorized();
+    vector<BitPlane> threats(2 * positions);
+    for (bool vectorized : {false, true}) {
+        if (vectorized && !avx2) {
+            continue;
+        }
+        Alignments::vectorized(vectorized);
+        start = chrono::steady_clock::now();
+        for (unsigned i = 0; i < positions; i++) {
+            threats[2 * i] = Alignments::threats(boards[i], Color::BLACK, power);
+            threats[2 * i + 1] = Alignments::threats(boards[i], Color::WHITE,
+                                                     power);
+        }
+        double kernelSeconds = chrono::duration<double>(
+                    chrono::steady_clock::now() - start).count();
+
+        for (unsigned i = 0; i < 2 * positions; i++) {
+            if (threats[i] != expected[i]) {
+                Alignments::vectorized(avx2);
+                throw logic_error("Threat mismatch between the cell scan and "
+                                  "the kernel");
+            }
+            if (Alignments::aligned(boards[i / 2], colors[i % 2], power)
+                    != alignments[i]) {
+                Alignments::vectorized(avx2);
+                throw logic_error("Alignment mismatch between the cell scan "
+                                  "and the kernel");
+            }
+        }
+
+        cout << setw(14) << (vectorized ? "kernel, AVX2" : "kernel")
+             << setw(12) << setprecision(3) << kernelSeconds << setw(14)
+             << setprecision(0) << positions / kernelSeconds << setw(10)
+             << setprecision(2) << cellSeconds / kernelSeconds << endl;
+    }
+    Alignments::vectorized(avx2);
+}
+
+/*!
+ * \brief Game record benchmark.
+ * Play random games, then time writing their records to memory, reading
+ * them back and replaying them on ConnectN.
+ * \param games the number of games
+ * \param power the number of pieces to align
+ * \param lines the number of lines of the board
+ * \param columns the number of columns of the board
+ */
+void benchRecords(unsigned games, unsigned power, unsigned lines,
+                  unsigned columns)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    Random random(games);
+    vector<GameRecord> records;
+    uint64_t moves = 0;
+
+    for (unsigned i = 0; i < games; i++) {
+        ConnectN game(power, lines, columns, random());
+        game.enroll(&player1);
+        game.enroll(&player2);
+        while (!game.finished()) {
+            while (game.tryPlay(random.below(columns))
+                    != ConnectN::MoveStatus::PLAYED) {
+            }
+        }
+        records.push_back(GameRecord::of(game));
+        moves += game.movesPlayed();
+    }
+
+    stringstream stream(ios::in | ios::out | ios::binary);
+    auto start = chrono::steady_clock::now();
+    {
+        RecordWriter writer(stream);
+        for (const GameRecord &record : records) {
+            writer.write(record);
+        }
+    }
+    double writeSeconds = chrono::duration<double>(chrono::steady_clock::now()
+                                                   - start).count();
+    size_t bytes = stream.str().size();
+
+    GameRecord record;
+    start = chrono::steady_clock::now();
+    RecordReader reader(stream);
+    while (reader.next(record)) {
+    }
+    double readSeconds = chrono::duration<double>(chrono::steady_clock::now()
+                                                  - start).count();
+
+    stream.clear();
+    stream.seekg(0);
+    start = chrono::steady_clock::now();
+    RecordReader replayer(stream);
+    uint64_t replayed = 0;
+    while (replayer.next(record)) {
+        ConnectN game(power, lines, columns, 0);
+        record.replay(game, &player1, &player2);
+        replayed += game.movesPlayed();
+    }
+    double replaySeconds = chrono::duration<double>(chrono::steady_clock::now()
+                                                    - start).count();
+    if (reader.records() != games || replayed != moves) {
+        throw logic_error("Records lost between the writer and the reader");
+    }
+
+    cout << "Records, power " << power << ", " << lines << "x" << columns
+         << " board, " << games << " random games, " << fixed
+         << setprecision(1) << double(moves) / games << " moves and "
+         << double(bytes) / games << " bytes per game" << endl;
+    cout << setw(14) << "step" << setw(12) << "seconds" << setw(14)
+         << "games/s" << setw(14) << "MB/s" << endl;
+    const pair<const char *, double> steps[] = {
+        { "write", writeSeconds }, { "read", readSeconds },
+        { "read, replay", replaySeconds }
+    };
+    for (const auto &step : steps) {
+        cout << setw(14) << step.first << setw(12) << setprecision(3)
+             << step.second << setw(14) << setprecision(0)
+             << games / step.second << setw(14) << setprecision(1)
+             << bytes / step.second / 1e6 << endl;
+    }
+}
+
+/*!
+ * \brief An output buffer that only counts the characters written to it
+ */
+class CountingBuffer : public streambuf
+{
+private:
+    uint64_t _count;
+
+protected:
+    /*!
+     * \brief Count a character
+     * \param c the character
+     * \return the character
+     */
+    int_type overflow(int_type c) override
+    {
+        _count++;
+        return c;
+    }
+
+    /*!
+     * \brief Count characters
+     * \param s the characters
+     * \param n the number of characters
+     * \return the number of characters
+     */
+    streamsize xsputn(const char *s, streamsize n) override
+    {
+        (void)s;
+        _count += n;
+        return n;
+    }
+
+public:
+    /*!
+     * \brief CountingBuffer constructor
+     */
+    CountingBuffer() :
+        _count(0)
+    { }
+
+    /*!
+     * \brief Return the number of characters written
+     * \return the number of characters written
+     */
+    uint64_t count() const
+    {
+        return _count;
+    }
+};
+
+/*!
+ * \brief The drawing of a board before BoardView: the game is copied, the
+ * board is copied line by line and every line is flushed
+ * \param out the output stream
+ * \param in the game
+ */
+void drawCopy(ostream &out, ConnectN in)
+{
+    for (unsigned column = 0; column < in.column(); column++) {
+        out << setw(3) << column << ' ';
+    }
+    out << endl;
+    for (unsigned i = 0; i < in.column() * 4 + 1; i++) {
+        out << (i % 4 == 0 ? '|' : '-');
+    }
+    out << endl;
+    for (auto line : in.board()) {
+        out << "| ";
+        for (auto cell : line) {
+            out << cell << " | ";
+        }
+        out << endl;
+        for (unsigned i = 0; i < in.column() * 4 + 1; i++) {
+            out << (i % 4 == 0 ? '|' : '-');
+        }
+        out << endl;
+    }
+    for (unsigned column = 0; column < in.column(); column++) {
+        out << setw(3) << column << ' ';
+    }
+    out << endl;
+}
+
+/*!
+ * \brief Rendering benchmark.
+ * Draw every position of random games to a counting stream, with the
+ * drawing of a copied game, with operator<<, and with a BoardView redrawing
+ * the cell of each move, and report the boards drawn per second.
+ * \param games the number of games
+ * \param power the number of pieces to align
+ * \param lines the number of lines of the board
+ * \param columns the number of columns of the board
+ */
+void benchRender(unsigned games, unsigned power, unsigned lines,
+                 unsigned columns)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    Random random(games);
+    vector<GameRecord> records;
+    uint64_t boards = 0;
+
+    for (unsigned i = 0; i < games; i++) {
+        ConnectN game(power, lines, columns, random());
+        game.enroll(&player1);
+        game.enroll(&player2);
+        while (!game.finished()) {
+            while (game.tryPlay(random.below(columns))
+                    != ConnectN::MoveStatus::PLAYED) {
+            }
+        }
+        records.push_back(GameRecord::of(game));
+        boards += game.movesPlayed();
+    }
+
+    /* draw each position of each game with the given function */
+    auto time = [&](const function<void(ostream &, const ConnectN &)> &draw,
+                    uint64_t &characters) {
+        CountingBuffer buffer;
+        ostream out(&buffer);
+        auto start = chrono::steady_clock::now();
+        for (const GameRecord &record : records) {
+            ConnectN game(power, lines, columns, 0);
+            game.enroll(&player1, &player2, record.color, record.active);
+            for (unsigned char column : record.moves) {
+                game.play(column);
+                draw(out, game);
+            }
+        }
+        characters = buffer.count();
+        return chrono::duration<double>(chrono::steady_clock::now()
+                                        - start).count();
+    };
+
+    BoardView view(lines, columns);
+    uint64_t copyCharacters;
+    uint64_t streamCharacters;
+    uint64_t viewCharacters;
+    double copySeconds = time([](ostream &out, const ConnectN &game) {
+        drawCopy(out, game);
+    }, copyCharacters);
+    double streamSeconds = time([](ostream &out, const ConnectN &game) {
+        out << game;
+    }, streamCharacters);
+    double viewSeconds = time([&view](ostream &out, const ConnectN &game) {
+        const string &text = view.render(game);
+        out.write(text.data(), text.size());
+    }, viewCharacters);
+    if (copyCharacters != streamCharacters
+            || viewCharacters != streamCharacters) {
+        throw logic_error("Drawing size mismatch");
+    }
+
+    /* compare the drawings byte for byte, drawing on the same view each
+     * position of each game and then of the same game, colors swapped */
+    for (const GameRecord &record : records) {
+        Color swapped = record.color == Color::BLACK ? Color::WHITE
+                                                     : Color::BLACK;
+        array<ConnectN, 2> twins{{ConnectN(power, lines, columns, 0),
+                                  ConnectN(power, lines, columns, 0)}};
+        twins[0].enroll(&player1, &player2, record.color, record.active);
+        twins[1].enroll(&player1, &player2, swapped, record.active);
+        for (unsigned char column : record.moves) {
+            for (ConnectN &game : twins) {
+                game.play(column);
+                ostringstream copy;
+                ostringstream stream;
+                drawCopy(copy, game);
+                stream << game;
+                if (copy.str() != stream.str()
+                        || view.render(game) != stream.str()) {
+                    throw logic_error("Drawing mismatch");
+                }
+            }
+        }
+    }
+
+    cout << "Rendering, " << lines << "x" << columns << " board, " << boards
+         << " boards of " << games << " random games" << endl;
+    cout << setw(14) << "drawing" << setw(12) << "seconds" << setw(14)
+         << "boards/s" << setw(10) << "speedup" << endl;
+    const pair<const char *, double> drawings[] = {
+        { "game copy", copySeconds }, { "operator<<", streamSeconds },
+        { "BoardView", viewSeconds }
+    };
+    for (const auto &drawing : drawings) {
+        cout << setw(14) << drawing.first << setw(12) << fixed
+             << setprecision(3) << drawing.second << setw(14) << setprecision(0)
+             << boards / drawing.second << setw(10) << setprecision(2)
+             << copySeconds / drawing.second << endl;
+    }
+}
+
+/*!
+ * \brief Count the distinct positions of the first moves
+ * \param game the game to walk, restored on return
+ * \param plies the number of moves to play
+ * \param hashes filled with the hash of each position
+ * \param symmetric `true` to count a position and its mirror once
+ */
+void distinctPositions(ConnectN &game, unsigned plies,
+                       unordered_set<uint64_t> &hashes, bool symmetric)
+{
+    uint64_t hash = symmetric ? game.canonicalHash() : game.hash();
+    if (!hashes.insert(hash).second || plies == 0 || game.finished()) {
+        return;
+    }
+    for (unsigned column = 0; column < game.column(); column++) {
+        if (game.tryPlay(column) == ConnectN::MoveStatus::PLAYED) {
+            distinctPositions(game, plies - 1, hashes, symmetric);
+            game.undo();
+        }
+    }
+}
+
+/*!
+ * \brief Symmetry benchmark.
+ * On the default board, compare with and without symmetry the positions of
+ * an opening book, a Negamax search from the empty board, and optionally
+ * the solving of a position.
+ * \param depth the depth of the search
+ * \param plies the number of moves of the book
+ * \param moves the columns played to reach the position to solve, none to
+ * skip the solver
+ */
+void benchSymmetry(unsigned depth, unsigned plies,
+                   const vector<unsigned> &moves)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    ConnectN game;
+    game.enroll(&player1);
+    game.enroll(&player2);
+
+    cout << "Symmetry, default board" << endl;
+    cout << setw(24) << "" << setw(14) << "plain" << setw(14) << "symmetric"
+         << setw(10) << "ratio" << endl;
+
+    unordered_set<uint64_t> plain;
+    unordered_set<uint64_t> symmetric;
+    distinctPositions(game, plies, plain, false);
+    distinctPositions(game, plies, symmetric, true);
+    cout << setw(24) << ("book positions, " + to_string(plies) + " plies")
+         << setw(14) << plain.size() << setw(14) << symmetric.size()
+         << setw(10) << fixed << setprecision(2)
+         << double(symmetric.size()) / plain.size() << endl;
+
+    array<SearchStats, 2> stats;
+    array<unsigned, 2> best;
+    for (unsigned i = 0; i < 2; i++) {
+        Negamax search(depth, make_shared<TranspositionTable>(64));
+        search.symmetry(i == 1);
+        best[i] = search.bestMove(game);
+        stats[i] = search.stats();
+    }
+    cout << setw(24) << ("search nodes, depth " + to_string(depth))
+         << setw(14) << stats[0].nodes << setw(14) << stats[1].nodes
+         << setw(10) << double(stats[1].nodes) / stats[0].nodes << endl;
+    cout << setw(24) << "search seconds" << setw(14) << setprecision(3)
+         << stats[0].seconds << setw(14) << stats[1].seconds << setw(10)
+         << setprecision(2) << stats[1].seconds / stats[0].seconds << endl;
+    cout << setw(24) << "search move" << setw(14) << best[0] << setw(14)
+         << best[1] << endl;
+
+    if (moves.empty()) {
+        return;
+    }
+    for (unsigned column : moves) {
+        game.play(column);
+    }
+    array<Solver::Result, 2> results;
+    array<uint64_t, 2> nodes;
+    array<double, 2> seconds;
+    for (unsigned i = 0; i < 2; i++) {
+        Solver solver;
+        solver.symmetry(i == 1);
+        auto start = chrono::steady_clock::now();
+        results[i] = solver.solve(game);
+        seconds[i] = chrono::duration<double>(chrono::steady_clock::now()
+                                              - start).count();
+        nodes[i] = solver.nodes();
+    }
+    if (results[0].score != results[1].score) {
+        throw logic_error("Solver scores differ with symmetry");
+    }
+    cout << setw(24) << ("solver nodes, " + to_string(moves.size())
+                         + " moves") << setw(14) << nodes[0] << setw(14)
+         << nodes[1] << setw(10) << double(nodes[1]) / nodes[0] << endl;
+    cout << setw(24) << "solver seconds" << setw(14) << setprecision(3)
+         << seconds[0] << setw(14) << seconds[1] << setw(10)
+         << setprecision(2) << seconds[1] / seconds[0] << endl;
+}
+
+/*!
+ * \brief Move ordering benchmark.
+ * Search the empty default board and random openings to a fixed depth with
+ * each MoveOrder heuristic, and report the nodes and the time of each
+ * against the naive left to right order.
+ * \param depth the search depth
+ * \param positions the number of positions, the empty board included
+ * \param plies the number of random moves of an opening
+ */
+void benchOrdering(unsigned depth, unsigned positions, unsigned plies)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    Random random(positions);
+    vector<ConnectN> games;
+
+    while (games.size() < positions) {
+        ConnectN game;
+        game.enroll(&player1);
+        game.enroll(&player2);
+        for (unsigned i = 0; !games.empty() && i < plies && !game.finished();
+             i++) {
+            while (game.tryPlay(random.below(game.column()))
+                    != ConnectN::MoveStatus::PLAYED) {
+            }
+        }
+        if (!game.finished()) {
+            games.push_back(game);
+        }
+    }
+
+    cout << "Move ordering, default board, depth " << depth << ", "
+         << positions << " positions" << endl;
+    cout << setw(10) << "ordering" << setw(12) << "seconds" << setw(14)
+         << "nodes" << setw(14) << "nodes/s" << setw(10) << "nodes" << setw(10)
+         << "time" << endl;
+    const array<pair<MoveOrder::Heuristic, const char *>, 3> heuristics{{
+        {MoveOrder::Heuristic::COLUMN, "column"},
+        {MoveOrder::Heuristic::CENTER, "center"},
+        {MoveOrder::Heuristic::THREATS, "threats"}
+    }};
+    uint64_t naiveNodes = 0;
+    double naiveSeconds = 0;
+    for (const auto &heuristic : heuristics) {
+        uint64_t nodes = 0;
+        double seconds = 0;
+        for (const ConnectN &game : games) {
+            Negamax search(depth, make_shared<TranspositionTable>(64));
+            search.ordering(heuristic.first);
+            search.bestMove(game);
+            nodes += search.stats().nodes;
+            seconds += search.stats().seconds;
+        }
+        /* the naive order comes first and is the reference */
+        if (heuristic.first == MoveOrder::Heuristic::COLUMN) {
+            naiveNodes = nodes;
+            naiveSeconds = seconds;
+        }
+        cout << setw(10) << heuristic.second << setw(12) << fixed
+             << setprecision(3) << seconds << setw(14) << nodes << setw(14)
+             << setprecision(0) << nodes / seconds << setw(10)
+             << setprecision(2) << double(nodes) / naiveNodes << setw(10)
+             << seconds / naiveSeconds << endl;
+    }
+}
+
+/*!
+ * \brief Illegal move benchmark.
+ * Play random columns, a third of them out of the board, in games that are
+ * restarted when finished, once through play() and its exceptions and once
+ * through tryPlay(), and report the attempts per second of each.
+ * \param attempts the number of columns tried
+ */
+void benchTryPlay(unsigned attempts)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    vector<unsigned> columns(attempts);
+    Random random(attempts);
+    for (unsigned &column : columns) {
+        column = random.below(ConnectN::DEFAULT_COLUMN * 3 / 2);
+    }
+
+    /* play the columns with the given function, false for illegal moves */
+    auto time = [&](const function<bool(ConnectN &, unsigned)> &play,
+                    unsigned &illegal) {
+        ConnectN game(ConnectN::DEFAULT_POWER, ConnectN::DEFAULT_LINE,
+                      ConnectN::DEFAULT_COLUMN, 0);
+        game.enroll(&player1, &player2, Color::BLACK, 0);
+        illegal = 0;
+        auto start = chrono::steady_clock::now();
+        for (unsigned column : columns) {
+            if (game.finished()) {
+                while (game.movesPlayed() > 0) {
+                    game.undo();
+                }
+            }
+            illegal += !play(game, column);
+        }
+        return chrono::duration<double>(chrono::steady_clock::now()
+                                        - start).count();
+    };
+
+    unsigned throwing;
+    unsigned trying;
+    double throwSeconds = time([](ConnectN &game, unsigned column) {
+        try {
+            game.play(column);
+            return true;
+        } catch (const logic_error &) {
+            return false;
+        }
+    }, throwing);
+    double trySeconds = time([](ConnectN &game, unsigned column) {
+        return game.tryPlay(column) == ConnectN::MoveStatus::PLAYED;
+    }, trying);
+    if (throwing != trying) {
+        throw logic_error("play() and tryPlay() disagree");
+    }
+
+    cout << "Illegal moves, default board, " << attempts << " attempts, "
+         << trying << " illegal" << endl;
+    cout << setw(14) << "method" << setw(12) << "seconds" << setw(14)
+         << "attempts/s" << setw(10) << "speedup" << endl;
+    cout << setw(14) << "play, throw" << setw(12) << fixed << setprecision(3)
+         << throwSeconds << setw(14) << setprecision(0)
+         << attempts / throwSeconds << setw(10) << setprecision(2) << 1.0
+         << endl;
+    cout << setw(14) << "tryPlay" << setw(12) << setprecision(3) << trySeconds
+         << setw(14) << setprecision(0) << attempts / trySeconds << setw(10)
+         << setprecision(2) << throwSeconds / trySeconds << endl;
+}
+
+/*!
+ * \brief Snapshot benchmark.
+ * Take snapshots of random games, as ConnectN copies, as Position values
+ * and as Position bytes copied with memcpy, restore games from the
+ * positions, and report the snapshots per second of each. Each restored
+ * game is checked against the original, move history included.
+ * \param games the number of random games
+ */
+void benchSnapshot(unsigned games)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    Random random(games);
+    vector<ConnectN> originals;
+
+    for (unsigned i = 0; i < games; i++) {
+        ConnectN game(ConnectN::DEFAULT_POWER, ConnectN::DEFAULT_LINE,
+                      ConnectN::DEFAULT_COLUMN, i);
+        game.enroll(&player1);
+        game.enroll(&player2);
+        unsigned moves = random.below(game.line() * game.column());
+        for (unsigned j = 0; j < moves && !game.finished(); j++) {
+            while (game.tryPlay(random.below(game.column()))
+                    != ConnectN::MoveStatus::PLAYED) {
+            }
+        }
+        originals.push_back(game);
+    }
+
+    /* run a snapshot function over all the games, a few times */
+    const unsigned rounds = 10;
+    auto time = [&](const function<void(size_t)> &snapshot) {
+        auto start = chrono::steady_clock::now();
+        for (unsigned round = 0; round < rounds; round++) {
+            for (size_t i = 0; i < originals.size(); i++) {
+                snapshot(i);
+            }
+        }
+        return chrono::duration<double>(chrono::steady_clock::now()
+                                        - start).count();
+    };
+
+    vector<ConnectN> copies(originals);
+    vector<Position> positions(originals.size());
+    vector<Position> bytes(originals.size());
+    vector<ConnectN> restored(originals);
+    double copySeconds = time([&](size_t i) {
+        copies[i] = originals[i];
+    });
+    double positionSeconds = time([&](size_t i) {
+        positions[i] = originals[i].position();
+    });
+    double memcpySeconds = time([&](size_t i) {
+        memcpy(&bytes[i], &positions[i], sizeof(Position));
+    });
+    double restoreSeconds = time([&](size_t i) {
+        restored[i] = ConnectN(bytes[i], originals[i].players()[0].first,
+                               originals[i].players()[1].first);
+    });
+
+    for (size_t i = 0; i < originals.size(); i++) {
+        ConnectN &original = originals[i];
+        ConnectN &game = restored[i];
+        if (game.hash() != original.hash()
+                || game.activePlayer() != original.activePlayer()
+                || game.winner() != original.winner()
+                || game.finished() != original.finished()
+                || game.color(&player1) != original.color(&player1)) {
+            throw logic_error("Restored game differs from the original");
+        }
+        while (original.movesPlayed() > 0) {
+            if (game.move(game.movesPlayed() - 1)
+                    != original.move(original.movesPlayed() - 1)) {
+                throw logic_error("Restored history differs from the original");
+            }
+            game.undo();
+            original.undo();
+            if (game.hash() != original.hash()) {
+                throw logic_error("Restored game differs after undo");
+            }
+        }
+    }
+
+    uint64_t snapshots = uint64_t(rounds) * games;
+    cout << "Snapshots, default board, " << games << " games" << endl;
+    cout << setw(16) << "method" << setw(8) << "bytes" << setw(12)
+         << "seconds" << setw(14) << "snapshots/s" << endl;
+    const array<pair<const char *, pair<size_t, double>>, 4> methods{{
+        {"ConnectN copy", {sizeof(ConnectN), copySeconds}},
+        {"position()", {sizeof(Position), positionSeconds}},
+        {"Position memcpy", {sizeof(Position), memcpySeconds}},
+        {"ConnectN(Position)", {sizeof(ConnectN), restoreSeconds}}
+    }};
+    for (const auto &method : methods) {
+        cout << setw(16) << method.first << setw(8) << method.second.first
+             << setw(12) << fixed << setprecision(3) << method.second.second
+             << setw(14) << setprecision(0)
+             << snapshots / method.second.second << endl;
+    }
+}
+
+/*!
+ * \brief Allocation benchmark.
+ * Search random positions of the default board with each engine, after a
+ * first search to warm up its arena and node pool, and report the calls to
+ * the global allocator made by the searches, which should be none.
+ * \param searches the number of positions searched by each engine
+ */
+void benchAllocations(unsigned searches)
+{
+    Player player1 { "bench 1" };
+    Player player2 { "bench 2" };
+    Random random(searches);
+    vector<ConnectN> positions;
+
+    while (positions.size() < searches + 1) {
+        ConnectN game;
+        game.enroll(&player1);
+        game.enroll(&player2);
+        for (unsigned i = 0; i < 6 && !game.finished(); i++) {
+            while (game.tryPlay(random.below(game.column()))
+                    != ConnectN::MoveStatus::PLAYED) {
+            }
+        }
+        if (!game.finished()) {
+            positions.push_back(game);
+        }
+    }
+
+    Negamax negamax(8);
+    Negamax tabled(8, make_shared<TranspositionTable>(16));
+    Mcts mcts(20000);
+    const array<pair<const char *, Engine *>, 3> engines{{
+        {"negamax", &negamax},
+        {"negamax+table", &tabled},
+        {"mcts", &mcts}
+    }};
+
+    cout << "Allocations, default board, " << searches << " searches" << endl;
+    cout << setw(14) << "engine" << setw(12) << "seconds" << setw(12)
+         << "mallocs" << setw(16) << "mallocs/search" << endl;
+    for (const auto &engine : engines) {
+        engine.second->bestMove(positions[0]);
+        uint64_t before = heapAllocations;
+        auto start = chrono::steady_clock::now();
+        for (unsigned i = 1; i <= searches; i++) {
+            engine.second->bestMove(positions[i]);
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now()
+                                                  - start).count();
+        uint64_t mallocs = heapAllocations - before;
+        cout << setw(14) << engine.first << setw(12) << fixed
+             << setprecision(3) << seconds << setw(12) << mallocs
+             << setw(16) << setprecision(2) << double(mallocs) / searches
+             << endl;
+    }
+    cout << "Arena of the main thread: " << Arena::local().capacity()
+         << " bytes in " << Arena::local().allocations() << " blocks" << endl;
+}
+
+/*!
+ * \brief Print the usage of the benchmark tool
+ * \param name the name of the program
+ */
+void usage(const string &name)
+{
+    cerr << "Usage: " << name << " <benchmark> [arguments]" << endl;
+    cerr << "  smp [depth] [max threads]   Lazy SMP speedup per thread count"
+         << endl;
+    cerr << "  allocations [searches]      Global allocator calls of the searches"
+         << endl;
+    cerr << "  fixed [power] [lines] [columns] [depth]" << endl;
+    cerr << "                              FixedBoard perft against ConnectN"
+         << endl;
+    cerr << "  mcts [playouts] [max threads] [power] [lines] [columns]"
+         << endl;
+    cerr << "                              MCTS playouts/s per thread count"
+         << endl;
+    cerr << "  ordering [depth] [positions] [plies]" << endl;
+    cerr << "                              Search nodes of each move ordering"
+         << endl;
+    cerr << "  perft [power] [lines] [columns] [depth] [column...]" << endl;
+    cerr << "                              Leaves of the game tree per depth,"
+         << endl;
+    cerr << "                              after the given columns are played"
+         << endl;
+    cerr << "  records [games] [power] [lines] [columns]" << endl;
+    cerr << "                              Game record write, read and replay"
+         << endl;
+    cerr << "  render [games] [power] [lines] [columns]" << endl;
+    cerr << "                              Boards drawn per second" << endl;
+    cerr << "  snapshot [games]            Game snapshots as ConnectN and Position"
+         << endl;
+    cerr << "  symmetry [depth] [plies] [column...]" << endl;
+    cerr << "                              Book, search and solver savings of"
+         << endl;
+    cerr << "                              symmetry on the default board" << endl;
+    cerr << "  threats [power] [lines] [columns] [positions]" << endl;
+    cerr << "                              Whole-board threats against a cell scan"
+         << endl;
+    cerr << "  tryplay [attempts]          Illegal moves through play() and tryPlay()"
+         << endl;
+}
+
+/*!
+ * \brief Benchmark program
+ * \param argc number of arguments
+ * \param argv arguments, see usage()
+ * \return 0 if everything went fine
+ */
+int main(int argc, char *argv[])
+{
+    if (argc < 2) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    string benchmark = argv[1];
+    try {
+        if (benchmark == "smp") {
+            unsigned cores = max(thread::hardware_concurrency(), 1u);
+            benchSmp(argument(argc, argv, 2, 16), argument(argc, argv, 3, cores));
+        } else if (benchmark == "allocations") {
+            benchAllocations(argument(argc, argv, 2, 20));
+        } else if (benchmark == "fixed") {
+            benchFixed(argument(argc, argv, 2, ConnectN::DEFAULT_POWER),
+                       argument(argc, argv, 3, ConnectN::DEFAULT_LINE),
+                       argument(argc, argv, 4, ConnectN::DEFAULT_COLUMN),
+                       argument(argc, argv, 5, 9));
+        } else if (benchmark == "mcts") {
+            unsigned cores = max(thread::hardware_concurrency(), 1u);
+            benchMcts(argument(argc, argv, 2, Mcts::DEFAULT_PLAYOUTS),
+                      argument(argc, argv, 3, cores),
+                      argument(argc, argv, 4, ConnectN::DEFAULT_POWER),
+                      argument(argc, argv, 5, ConnectN::DEFAULT_LINE),
+                      argument(argc, argv, 6, ConnectN::DEFAULT_COLUMN));
+        } else if (benchmark == "ordering") {
+            benchOrdering(argument(argc, argv, 2, 10),
+                          argument(argc, argv, 3, 20),
+                          argument(argc, argv, 4, 6));
+        } else if (benchmark == "perft") {
+            vector<unsigned> moves;
+            for (int i = 6; i < argc; i++) {
+                moves.push_back(nvs::fromString<unsigned>(argv[i]));
+            }
+            benchPerft(argument(argc, argv, 2, ConnectN::DEFAULT_POWER),
+                       argument(argc, argv, 3, ConnectN::DEFAULT_LINE),
+                       argument(argc, argv, 4, ConnectN::DEFAULT_COLUMN),
+                       argument(argc, argv, 5, 8), moves);
+        } else if (benchmark == "records") {
+            benchRecords(argument(argc, argv, 2, 1000000),
+                         argument(argc, argv, 3, ConnectN::DEFAULT_POWER),
+                         argument(argc, argv, 4, ConnectN::DEFAULT_LINE),
+                         argument(argc, argv, 5, ConnectN::DEFAULT_COLUMN));
+        } else if (benchmark == "render") {
+            benchRender(argument(argc, argv, 2, 10000),
+                        argument(argc, argv, 3, ConnectN::DEFAULT_POWER),
+                        argument(argc, argv, 4, ConnectN::DEFAULT_LINE),
+                        argument(argc, argv, 5, ConnectN::DEFAULT_COLUMN));
+        } else if (benchmark == "snapshot") {
+            benchSnapshot(argument(argc, argv, 2, 100000));
+        } else if (benchmark == "symmetry") {
+            vector<unsigned> moves;
+            for (int i = 4; i < argc; i++) {
+                moves.push_back(nvs::fromString<unsigned>(argv[i]));
+            }
+            benchSymmetry(argument(argc, argv, 2, 12),
+                          argument(argc, argv, 3, 8), moves);
+        } else if (benchmark == "tryplay") {
+            benchTryPlay(argument(argc, argv, 2, 1000000));
+        } else if (benchmark == "threats") {
+            benchThreats(argument(argc, argv, 2, ConnectN::DEFAULT_POWER),
+                         argument(argc, argv, 3, ConnectN::DEFAULT_LINE),
+                         argument(argc, argv, 4, ConnectN::DEFAULT_COLUMN),
+                         argument(argc, argv, 5, 100000));
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    } catch (const nvs::bad_string_convert &) {
+        usage(argv[0]);
+        return 1;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
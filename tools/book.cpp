@@ -0,0 +1,168 @@
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "ConnectN.h"
+#include "Negamax.h"
+#include "OpeningBook.h"
+#include "Player.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+#include "libs/stringConvert.hpp"
+
+using namespace std;
+
+/*!
+ * \brief Print the usage of the book generator
+ * \param name the name of the program
+ */
+void usage(const string &name)
+{
+    cerr << "Usage: " << name << " [--plies N] [--depth D] [--threads T]"
+         << " [--hash MB] [--symmetric 0|1]" << endl;
+    cerr << "    <power> <lines> <columns> <file>" << endl;
+    cerr << "  Search every position of the first N moves to depth D and"
+         << endl;
+    cerr << "  write the best moves to an opening book; a symmetric book"
+         << endl;
+    cerr << "  only keeps one of a position and its mirror" << endl;
+}
+
+/*!
+ * \brief List the distinct positions reached by playing fewer than the
+ * given number of moves, finished games excluded
+ * \param game the empty game
+ * \param plies the number of moves
+ * \param symmetric `true` to list one of a position and its mirror
+ * \return the positions
+ */
+vector<ConnectN> positions(const ConnectN &game, unsigned plies,
+                           bool symmetric)
+{
+    auto key = [symmetric](const ConnectN &position) {
+        return symmetric ? position.canonicalHash() : position.hash();
+    };
+    vector<ConnectN> found;
+    vector<ConnectN> current { game };
+    unordered_set<uint64_t> seen { key(game) };
+
+    for (unsigned ply = 0; ply < plies && !current.empty(); ply++) {
+        vector<ConnectN> next;
+        for (const ConnectN &position : current) {
+            found.push_back(position);
+            if (ply + 1 == plies) {
+                continue;
+            }
+            for (unsigned column = 0; column < position.column(); column++) {
+                ConnectN child = position;
+                if (child.tryPlay(column) != ConnectN::MoveStatus::PLAYED) {
+                    continue;
+                }
+                if (!child.finished() && seen.insert(key(child)).second) {
+                    next.push_back(child);
+                }
+            }
+        }
+        current.swap(next);
+    }
+    return found;
+}
+
+/*!
+ * \brief Opening book generator
+ * \param argc number of arguments
+ * \param argv arguments, see usage()
+ * \return 0 if everything went fine
+ */
+int main(int argc, char *argv[])
+{
+    Player player1 { "book 1" };
+    Player player2 { "book 2" };
+    unsigned plies = 6;
+    unsigned depth = 12;
+    unsigned threads = max(thread::hardware_concurrency(), 1u);
+    size_t megabytes = 256;
+    bool symmetric = true;
+    int index = 1;
+
+    try {
+        for (; index + 1 < argc && argv[index][0] == '-'; index += 2) {
+            string option = argv[index];
+            if (option == "--plies") {
+                plies = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--depth") {
+                depth = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--threads") {
+                threads = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--hash") {
+                megabytes = nvs::fromString<size_t>(argv[index + 1]);
+            } else if (option == "--symmetric") {
+                symmetric = nvs::fromString<bool>(argv[index + 1]);
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        if (argc - index != 4 || threads == 0) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        unsigned power = nvs::fromString<unsigned>(argv[index]);
+        unsigned line = nvs::fromString<unsigned>(argv[index + 1]);
+        unsigned column = nvs::fromString<unsigned>(argv[index + 2]);
+        string path = argv[index + 3];
+        ConnectN game(power, line, column);
+        game.enroll(&player1);
+        game.enroll(&player2);
+
+        vector<ConnectN> found = positions(game, plies, symmetric);
+        vector<pair<uint64_t, unsigned>> moves(found.size());
+        auto table = make_shared<TranspositionTable>(megabytes);
+        auto start = chrono::steady_clock::now();
+        {
+            /* the searches share the table, as Lazy SMP helpers do */
+            ThreadPool pool(threads);
+            for (size_t i = 0; i < found.size(); i++) {
+                pool.submit([&found, &moves, &table, depth, symmetric, i]() {
+                    const ConnectN &position = found[i];
+                    Negamax search(depth, table);
+                    search.symmetry(symmetric);
+                    unsigned move = search.bestMove(position);
+                    /* a symmetric book is keyed by the canonical form */
+                    if (symmetric && position.mirrored()) {
+                        moves[i] = make_pair(position.mirrorHash(),
+                                             position.mirror(move));
+                    } else {
+                        moves[i] = make_pair(position.hash(), move);
+                    }
+                });
+            }
+            pool.wait();
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        OpeningBook::write(path, power, line, column, moves);
+        OpeningBook book(path);
+        cout << book.size() << (symmetric ? " symmetric" : "")
+             << " positions of the first " << plies
+             << " moves searched to depth " << depth << " in " << fixed
+             << setprecision(1) << elapsed.count() << " s on " << threads
+             << " threads, written to " << path << endl;
+    } catch (const nvs::bad_string_convert &) {
+        usage(argv[0]);
+        return 1;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
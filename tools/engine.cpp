@@ -0,0 +1,81 @@
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include "EngineProtocol.h"
+#include "OpeningBook.h"
+#include "TranspositionTable.h"
+#include "libs/stringConvert.hpp"
+
+using namespace std;
+
+/*!
+ * \brief Print the usage of the engine
+ * \param name the name of the program
+ */
+void usage(const string &name)
+{
+    cerr << "Usage: " << name << " [--threads T] [--hash MB] [--book FILE]"
+         << endl;
+    cerr << "  Read engine commands from the standard input and answer on"
+         << endl;
+    cerr << "  the standard output: uci, isready, newgame [P L C]," << endl;
+    cerr << "  position [startpos] [moves C...], go [depth D] [movetime MS]"
+         << endl;
+    cerr << "  [infinite], stop, quit" << endl;
+}
+
+/*!
+ * \brief Engine program, driven by another program through pipes
+ * \param argc number of arguments
+ * \param argv arguments, see usage()
+ * \return 0 if everything went fine
+ */
+int main(int argc, char *argv[])
+{
+    unsigned threads = 1;
+    size_t megabytes = 64;
+    string path;
+    int index = 1;
+
+    try {
+        for (; index + 1 < argc && argv[index][0] == '-'; index += 2) {
+            string option = argv[index];
+            if (option == "--threads") {
+                threads = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--hash") {
+                megabytes = nvs::fromString<size_t>(argv[index + 1]);
+            } else if (option == "--book") {
+                path = argv[index + 1];
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        if (index != argc || threads == 0) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        /* each answer is flushed at once, the other end waits for it */
+        EngineProtocol protocol([](const string &line) {
+            cout << line << endl;
+        }, make_shared<TranspositionTable>(megabytes), threads);
+        if (!path.empty()) {
+            protocol.search().book(make_shared<const OpeningBook>(path));
+        }
+
+        string command;
+        while (getline(cin, command) && protocol.execute(command)) {
+        }
+    } catch (const nvs::bad_string_convert &) {
+        usage(argv[0]);
+        return 1;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+TEMPLATE = app
+CONFIG += console release
+CONFIG -= app_bundle debug
+CONFIG -= qt
+
+TARGET = connectn_engine
+
+include(../src/connectn.pri)
+
+SOURCES += \
+    engine.cpp
+
+QMAKE_CXXFLAGS += -std=c++11 \
+    -pedantic-errors
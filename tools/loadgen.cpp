@@ -0,0 +1,332 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "ConnectN.h"
+#include "Player.h"
+#include "Random.h"
+#include "libs/stringConvert.hpp"
+
+using namespace std;
+
+/*!
+ * \brief What one connection did
+ */
+struct Load
+{
+    uint64_t moves; /*!< moves played, by the client and the server */
+    uint64_t games; /*!< games finished */
+    uint64_t errors; /*!< error answers */
+    vector<double> latencies; /*!< seconds from a play to its answer */
+};
+
+/*!
+ * \brief A client connection sending lines and reading whole lines
+ */
+class Client
+{
+private:
+    int _fd;
+    string _input;
+
+public:
+    /*!
+     * \brief Client constructor. Connect to the server.
+     * \param path the path of the socket of the server
+     * \throw runtime_error if the connection fails
+     */
+    explicit Client(const string &path) :
+        _fd(socket(AF_UNIX, SOCK_STREAM, 0)),
+        _input()
+    {
+        sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        if (_fd < 0 || connect(_fd, reinterpret_cast<sockaddr *>(&address),
+                               sizeof(address)) < 0) {
+            int error = errno;
+            close(_fd);
+            throw runtime_error("Cannot connect to " + path + ": "
+                                + strerror(error));
+        }
+    }
+
+    /*!
+     * \brief Client destructor. Close the connection.
+     */
+    ~Client()
+    {
+        close(_fd);
+    }
+
+    Client(const Client &) = delete;
+    Client &operator=(const Client &) = delete;
+
+    /*!
+     * \brief Send lines
+     * \param lines the lines, each ended by an end of line
+     * \throw runtime_error if the connection is lost
+     */
+    void send(const string &lines)
+    {
+        size_t sent = 0;
+        while (sent < lines.size()) {
+            ssize_t bytes = ::send(_fd, lines.data() + sent,
+                                   lines.size() - sent, MSG_NOSIGNAL);
+            if (bytes < 0 && errno != EINTR) {
+                throw runtime_error("Connection lost");
+            }
+            sent += max<ssize_t>(bytes, 0);
+        }
+    }
+
+    /*!
+     * \brief Read the next line
+     * \return the line, without its end of line
+     * \throw runtime_error if the connection is lost
+     */
+    string receive()
+    {
+        char buffer[4096];
+        size_t end;
+        while ((end = _input.find('\n')) == string::npos) {
+            ssize_t bytes = read(_fd, buffer, sizeof(buffer));
+            if (bytes <= 0 && !(bytes < 0 && errno == EINTR)) {
+                throw runtime_error("Connection lost");
+            }
+            _input.append(buffer, max<ssize_t>(bytes, 0));
+        }
+        string line = _input.substr(0, end);
+        _input.erase(0, end + 1);
+        return line;
+    }
+};
+
+/*!
+ * \brief Play random moves in many sessions of one connection until the
+ * deadline, every session waiting for the answer of its last command
+ * \param path the path of the socket of the server
+ * \param sessions the number of sessions
+ * \param deadline when to stop starting commands
+ * \param seed the seed of the random moves
+ * \param load filled with what the connection did
+ */
+void drive(const string &path, unsigned sessions,
+           chrono::steady_clock::time_point deadline, uint64_t seed,
+           Load &load)
+{
+    struct Game
+    {
+        ConnectN game;
+        chrono::steady_clock::time_point sent;
+    };
+    Player player1 { "client" };
+    Player player2 { "server" };
+    Random random(seed);
+    unordered_map<uint64_t, Game> games;
+    Client client(path);
+    unsigned pending = 0;
+
+    /* play a random move in a session and time its answer */
+    auto play = [&](uint64_t id, Game &local) {
+        uint32_t legal = local.game.legalMoves();
+        unsigned column;
+        do {
+            column = random.below(local.game.column());
+        } while (!(legal >> column & 1));
+        local.game.tryPlay(column);
+        local.sent = chrono::steady_clock::now();
+        client.send("play " + to_string(id) + " " + to_string(column) + "\n");
+        pending++;
+    };
+    /* close a session, and start another one until the deadline */
+    auto restart = [&](uint64_t id) {
+        games.erase(id);
+        string lines = "close " + to_string(id) + "\n";
+        pending++;
+        if (chrono::steady_clock::now() < deadline) {
+            lines += "new\n";
+            pending++;
+        }
+        client.send(lines);
+    };
+
+    string lines;
+    for (unsigned i = 0; i < sessions; i++) {
+        lines += "new\n";
+    }
+    client.send(lines);
+    pending = sessions;
+
+    while (pending > 0) {
+        istringstream in(client.receive());
+        pending--;
+        string answer;
+        uint64_t id = 0;
+        in >> answer >> id;
+        auto found = games.find(id);
+        if (answer == "new") {
+            Game &local = games.emplace(id, Game{ConnectN(), {}}).first->second;
+            local.game.enroll(&player1, &player2, Color::BLACK, 0);
+            play(id, local);
+        } else if (answer == "move" && found != games.end()) {
+            Game &local = found->second;
+            unsigned column = local.game.column();
+            in >> column;
+            load.latencies.push_back(chrono::duration<double>(
+                    chrono::steady_clock::now() - local.sent).count());
+            if (local.game.tryPlay(column) != ConnectN::MoveStatus::PLAYED) {
+                load.errors++;
+                restart(id);
+                continue;
+            }
+            load.moves += 2;
+            if (local.game.finished()
+                    || chrono::steady_clock::now() >= deadline) {
+                load.games += local.game.finished();
+                restart(id);
+            } else {
+                play(id, local);
+            }
+        } else if (answer == "end" && found != games.end()) {
+            load.latencies.push_back(chrono::duration<double>(
+                    chrono::steady_clock::now() - found->second.sent).count());
+            load.moves++;
+            load.games++;
+            restart(id);
+        } else if (answer == "error") {
+            load.errors++;
+            if (found != games.end()) {
+                restart(id);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Print the usage of the load generator
+ * \param name the name of the program
+ */
+void usage(const string &name)
+{
+    cerr << "Usage: " << name << " [--connections C] [--sessions S]"
+         << " [--seconds T] [--seed S] <socket>" << endl;
+    cerr << "  Play random moves against a game server for T seconds, over"
+         << endl;
+    cerr << "  C connections of S sessions each, and report the moves per"
+         << endl;
+    cerr << "  second and the latency of the answers" << endl;
+}
+
+/*!
+ * \brief Load generator program
+ * \param argc number of arguments
+ * \param argv arguments, see usage()
+ * \return 0 if everything went fine
+ */
+int main(int argc, char *argv[])
+{
+    unsigned connections = 4;
+    unsigned sessions = 256;
+    unsigned seconds = 10;
+    uint64_t seed = 0;
+    int index = 1;
+
+    try {
+        for (; index + 1 < argc && argv[index][0] == '-'; index += 2) {
+            string option = argv[index];
+            if (option == "--connections") {
+                connections = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--sessions") {
+                sessions = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--seconds") {
+                seconds = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--seed") {
+                seed = nvs::fromString<uint64_t>(argv[index + 1]);
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        if (argc - index != 1 || connections == 0 || sessions == 0) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        string path = argv[index];
+        vector<Load> loads(connections, Load{0, 0, 0, {}});
+        vector<thread> threads;
+        vector<string> failures(connections);
+        auto start = chrono::steady_clock::now();
+        auto deadline = start + chrono::seconds(seconds);
+        for (unsigned i = 0; i < connections; i++) {
+            threads.emplace_back([&, i]() {
+                try {
+                    drive(path, sessions, deadline, seed + i, loads[i]);
+                } catch (const exception &e) {
+                    failures[i] = e.what();
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now()
+                                                  - start).count();
+        for (const string &failure : failures) {
+            if (!failure.empty()) {
+                throw runtime_error(failure);
+            }
+        }
+
+        Load total{0, 0, 0, {}};
+        for (const Load &load : loads) {
+            total.moves += load.moves;
+            total.games += load.games;
+            total.errors += load.errors;
+            total.latencies.insert(total.latencies.end(),
+                                   load.latencies.begin(), load.latencies.end());
+        }
+        vector<double> &latencies = total.latencies;
+        sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](double rank) {
+            return latencies.empty() ? 0.0
+                    : 1000 * latencies[size_t(rank * (latencies.size() - 1))];
+        };
+
+        cout << connections << " connections, " << connections * sessions
+             << " sessions, " << fixed << setprecision(1) << elapsed << " s"
+             << endl;
+        cout << setw(14) << "moves" << setw(14) << "moves/s" << setw(10)
+             << "games" << setw(10) << "errors" << setw(12) << "p50 ms"
+             << setw(12) << "p99 ms" << setw(12) << "max ms" << endl;
+        cout << setw(14) << total.moves << setw(14) << setprecision(0)
+             << total.moves / elapsed << setw(10) << total.games << setw(10)
+             << total.errors << setw(12) << setprecision(3) << percentile(0.5)
+             << setw(12) << percentile(0.99) << setw(12) << percentile(1)
+             << endl;
+    } catch (const nvs::bad_string_convert &) {
+        usage(argv[0]);
+        return 1;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
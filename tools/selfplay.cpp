@@ -0,0 +1,154 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "ConnectN.h"
+#include "RecordWriter.h"
+#include "SelfPlay.h"
+#include "libs/stringConvert.hpp"
+
+using namespace std;
+
+/*!
+ * \brief Print the results of a series of games on one line
+ * \param result the results of the series
+ */
+void printResult(const MatchResult &result)
+{
+    cout << setw(9) << fixed << setprecision(1)
+         << 100.0 * result.wins / result.games << " %" << setw(9)
+         << 100.0 * result.draws / result.games << " %" << setw(9)
+         << 100.0 * result.losses / result.games << " %" << setw(12)
+         << setprecision(0) << result.gamesPerSecond() << endl;
+}
+
+/*!
+ * \brief Print the usage of the self-play tool
+ * \param name the name of the program
+ */
+void usage(const string &name)
+{
+    cerr << "Usage: " << name << " [--games M] [--threads N] [--seed S]"
+         << " [--record FILE]" << endl;
+    cerr << "    <engine> <engine> [<power> <lines> <columns> | sweep]" << endl;
+    cerr << "  Play M games between two engines on the given board, the"
+         << endl;
+    cerr << "  default board, or with sweep every board of the game, of P"
+         << endl;
+    cerr << "  to P + 10 lines and columns for each power P, and archive"
+         << endl;
+    cerr << "  the games to FILE" << endl;
+    cerr << "  Engines: random, greedy, search, search:<depth>, mcts,"
+         << " mcts:<playouts>" << endl;
+}
+
+/*!
+ * \brief Self-play program
+ * \param argc number of arguments
+ * \param argv arguments, see usage()
+ * \return 0 if everything went fine
+ */
+int main(int argc, char *argv[])
+{
+    unsigned games = 1000;
+    unsigned threads = max(thread::hardware_concurrency(), 1u);
+    uint64_t seed = 0;
+    string path;
+    int index = 1;
+
+    try {
+        for (; index + 1 < argc && argv[index][0] == '-'; index += 2) {
+            string option = argv[index];
+            if (option == "--games") {
+                games = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--threads") {
+                threads = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--seed") {
+                seed = nvs::fromString<uint64_t>(argv[index + 1]);
+            } else if (option == "--record") {
+                path = argv[index + 1];
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        int rest = argc - index;
+        if (games == 0 || (rest != 2 && rest != 3 && rest != 5)
+                || (rest == 3 && string(argv[index + 2]) != "sweep")) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        SelfPlay selfPlay(argv[index], argv[index + 1], threads);
+        ofstream file;
+        unique_ptr<RecordWriter> writer;
+        if (!path.empty()) {
+            file.open(path, ios::binary | ios::trunc);
+            writer.reset(new RecordWriter(file));
+            selfPlay.record(writer.get());
+        }
+        cout << argv[index] << " vs " << argv[index + 1] << ", " << games
+             << " games per board on " << threads << " threads" << endl;
+        cout << setw(6) << "power" << setw(7) << "board" << setw(11) << "wins"
+             << setw(11) << "draws" << setw(11) << "losses" << setw(12)
+             << "games/s" << endl;
+
+        if (rest == 3) {
+            MatchResult total{0, 0, 0, 0, 0};
+            /* the boards offered by the game: from power to power + 10
+             * lines and columns, where every direction can be won */
+            for (unsigned power = ConnectN::MIN_POWER;
+                 power <= ConnectN::MAX_POWER; power++) {
+                for (unsigned line = power; line <= power + 10; line++) {
+                    for (unsigned column = power; column <= power + 10;
+                         column++) {
+                        MatchResult result = selfPlay.play(power, line, column,
+                                                           games, seed);
+                        cout << setw(6) << power << setw(4) << line << "x"
+                             << left << setw(2) << column << right;
+                        printResult(result);
+                        total.games += result.games;
+                        total.wins += result.wins;
+                        total.losses += result.losses;
+                        total.draws += result.draws;
+                        total.seconds += result.seconds;
+                    }
+                }
+            }
+            cout << setw(13) << "all";
+            printResult(total);
+        } else {
+            unsigned power = ConnectN::DEFAULT_POWER;
+            unsigned line = ConnectN::DEFAULT_LINE;
+            unsigned column = ConnectN::DEFAULT_COLUMN;
+            if (rest == 5) {
+                power = nvs::fromString<unsigned>(argv[index + 2]);
+                line = nvs::fromString<unsigned>(argv[index + 3]);
+                column = nvs::fromString<unsigned>(argv[index + 4]);
+            }
+            MatchResult result = selfPlay.play(power, line, column, games,
+                                               seed);
+            cout << setw(6) << power << setw(4) << line << "x" << left
+                 << setw(2) << column << right;
+            printResult(result);
+        }
+
+        if (writer != nullptr) {
+            writer->flush();
+            cout << writer->records() << " games recorded to " << path << endl;
+        }
+    } catch (const nvs::bad_string_convert &) {
+        usage(argv[0]);
+        return 1;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
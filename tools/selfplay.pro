@@ -0,0 +1,14 @@
+TEMPLATE = app
+CONFIG += console release
+CONFIG -= app_bundle debug
+CONFIG -= qt
+
+TARGET = connectn_selfplay
+
+include(../src/connectn.pri)
+
+SOURCES += \
+    selfplay.cpp
+
+QMAKE_CXXFLAGS += -std=c++11 \
+    -pedantic-errors
@@ -0,0 +1,93 @@
+#include <csignal>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "GameServer.h"
+#include "libs/stringConvert.hpp"
+
+using namespace std;
+
+/*!
+ * \brief The server stopped by SIGINT and SIGTERM
+ */
+static GameServer *server = nullptr;
+
+/*!
+ * \brief Stop the server on a signal
+ * \param signal the signal received
+ */
+extern "C" void stopServer(int)
+{
+    if (server != nullptr) {
+        server->stop();
+    }
+}
+
+/*!
+ * \brief Print the usage of the game server
+ * \param name the name of the program
+ */
+void usage(const string &name)
+{
+    cerr << "Usage: " << name << " [--workers N] [--compute N] [--depth D]"
+         << " <socket>" << endl;
+    cerr << "  Serve games against a search of depth D on a Unix socket,"
+         << endl;
+    cerr << "  commands on N worker threads, searches on N compute threads,"
+         << endl;
+    cerr << "  until interrupted" << endl;
+}
+
+/*!
+ * \brief Game server program
+ * \param argc number of arguments
+ * \param argv arguments, see usage()
+ * \return 0 if everything went fine
+ */
+int main(int argc, char *argv[])
+{
+    unsigned cores = max(thread::hardware_concurrency(), 1u);
+    unsigned workers = 2;
+    unsigned compute = cores;
+    unsigned depth = GameServer::DEFAULT_DEPTH;
+    int index = 1;
+
+    try {
+        for (; index + 1 < argc && argv[index][0] == '-'; index += 2) {
+            string option = argv[index];
+            if (option == "--workers") {
+                workers = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--compute") {
+                compute = nvs::fromString<unsigned>(argv[index + 1]);
+            } else if (option == "--depth") {
+                depth = nvs::fromString<unsigned>(argv[index + 1]);
+            } else {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        if (argc - index != 1) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        GameServer game(argv[index], workers, compute, depth);
+        server = &game;
+        signal(SIGINT, stopServer);
+        signal(SIGTERM, stopServer);
+        cout << "Serving on " << argv[index] << " with " << workers
+             << " workers and " << compute << " compute threads" << endl;
+        game.run();
+        server = nullptr;
+        cout << game.moves() << " moves played" << endl;
+    } catch (const nvs::bad_string_convert &) {
+        usage(argv[0]);
+        return 1;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
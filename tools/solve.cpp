@@ -0,0 +1,98 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "ConnectN.h"
+#include "Player.h"
+#include "Solver.h"
+#include "libs/stringConvert.hpp"
+
+using namespace std;
+
+/*!
+ * \brief Print the usage of the solver tool
+ * \param name the name of the program
+ */
+void usage(const string &name)
+{
+    cerr << "Usage: " << name
+         << " [--hash MB] [--symmetric] <power> <lines> <columns> [column...]"
+         << endl;
+    cerr << "  Solve the position reached by playing the given columns;"
+         << endl;
+    cerr << "  mirrored positions share their hash entry with --symmetric"
+         << endl;
+}
+
+/*!
+ * \brief Solver program
+ * \param argc number of arguments
+ * \param argv arguments, see usage()
+ * \return 0 if everything went fine
+ */
+int main(int argc, char *argv[])
+{
+    Player player1 { "solver 1" };
+    Player player2 { "solver 2" };
+    size_t megabytes = Solver::DEFAULT_MEGABYTES;
+    bool symmetric = false;
+    int index = 1;
+
+    try {
+        if (index + 1 < argc && string(argv[index]) == "--hash") {
+            megabytes = nvs::fromString<size_t>(argv[index + 1]);
+            index += 2;
+        }
+        if (index < argc && string(argv[index]) == "--symmetric") {
+            symmetric = true;
+            index++;
+        }
+        if (argc - index < 3) {
+            usage(argv[0]);
+            return 1;
+        }
+
+        ConnectN game(nvs::fromString<unsigned>(argv[index]),
+                      nvs::fromString<unsigned>(argv[index + 1]),
+                      nvs::fromString<unsigned>(argv[index + 2]));
+        game.enroll(&player1);
+        game.enroll(&player2);
+        for (index += 3; index < argc; index++) {
+            game.play(nvs::fromString<unsigned>(argv[index]));
+        }
+
+        Solver solver(megabytes);
+        solver.symmetry(symmetric);
+        auto start = chrono::steady_clock::now();
+        Solver::Result result = solver.solve(game);
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+        switch (result.outcome) {
+        case Solver::Outcome::WIN:
+            cout << "win";
+            break;
+        case Solver::Outcome::DRAW:
+            cout << "draw";
+            break;
+        case Solver::Outcome::LOSS:
+            cout << "loss";
+            break;
+        }
+        cout << " in " << result.moves << " moves (score " << result.score
+             << ")" << endl;
+        cout << solver.nodes() << " nodes in " << fixed << setprecision(3)
+             << elapsed.count() << " s (" << setprecision(0)
+             << solver.nodes() / elapsed.count() << " nodes/s), TT hit rate "
+             << setprecision(1) << solver.hitRate() * 100 << " %"
+             << endl;
+    } catch (const nvs::bad_string_convert &) {
+        usage(argv[0]);
+        return 1;
+    } catch (const exception &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
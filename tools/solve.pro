@@ -0,0 +1,14 @@
+TEMPLATE = app
+CONFIG += console release
+CONFIG -= app_bundle debug
+CONFIG -= qt
+
+TARGET = connectn_solve
+
+include(../src/connectn.pri)
+
+SOURCES += \
+    solve.cpp
+
+QMAKE_CXXFLAGS += -std=c++11 \
+    -pedantic-errors